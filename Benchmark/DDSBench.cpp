@@ -0,0 +1,732 @@
+#include "HelloWorldPubSubTypes.h"
+#include "DomainTestPubSubTypes.h"
+#include "VehicleDiagnosticsPubSubTypes.h"
+#include "VehicleSystemsPubSubTypes.h"
+#include "ReliabilityTestPubSubTypes.h"
+#include "HistoryTestPubSubTypes.h"
+#include "SteeringControlPubSubTypes.h"
+#include "LatencyHistogram.hpp"
+#include "TransportConfig.hpp"
+
+#include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastdds/dds/domain/DomainParticipant.hpp>
+#include <fastdds/dds/topic/TypeSupport.hpp>
+#include <fastdds/dds/publisher/Publisher.hpp>
+#include <fastdds/dds/publisher/DataWriter.hpp>
+#include <fastdds/dds/publisher/qos/DataWriterQos.hpp>
+#include <fastdds/dds/subscriber/Subscriber.hpp>
+#include <fastdds/dds/subscriber/DataReader.hpp>
+#include <fastdds/dds/subscriber/DataReaderListener.hpp>
+#include <fastdds/dds/subscriber/qos/DataReaderQos.hpp>
+#include <fastdds/dds/subscriber/SampleInfo.hpp>
+#include <fastrtps/xmlparser/XMLProfileManager.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastdds::dds;
+
+// Per-type adapters: how to grow a sample to a payload size and which
+// field carries the sample id used to match ping/pong pairs.
+// max_payload() is the largest payload a bounded type can carry (0 = unbounded).
+template<typename T> struct BenchTraits;
+
+template<> struct BenchTraits<HelloWorld> {
+    typedef HelloWorldPubSubType PubSubType;
+    static bool sized() { return true; }
+    static size_t max_payload() { return 0; }
+    static void fill(HelloWorld& s, size_t payload) { s.message(std::string(payload, 'x')); }
+    static void set_id(HelloWorld& s, uint64_t id) { s.index(static_cast<uint32_t>(id)); }
+    static uint64_t id(const HelloWorld& s) { return s.index(); }
+};
+
+template<> struct BenchTraits<DomainTest> {
+    typedef DomainTestPubSubType PubSubType;
+    static bool sized() { return true; }
+    static size_t max_payload() { return 0; }
+    static void fill(DomainTest& s, size_t payload) { s.message(std::string(payload, 'x')); }
+    static void set_id(DomainTest& s, uint64_t id) { s.index(static_cast<uint32_t>(id)); }
+    static uint64_t id(const DomainTest& s) { return s.index(); }
+};
+
+template<> struct BenchTraits<VehicleDiagnostics> {
+    typedef VehicleDiagnosticsPubSubType PubSubType;
+    static bool sized() { return true; }
+    static size_t max_payload() { return 17; }
+    static void fill(VehicleDiagnostics& s, size_t payload) {
+        s.vehicle_id(eprosima::fastcdr::fixed_string<17>(std::string(payload, 'x')));
+    }
+    static void set_id(VehicleDiagnostics& s, uint64_t id) { s.timestamp(id); }
+    static uint64_t id(const VehicleDiagnostics& s) { return s.timestamp(); }
+};
+
+template<> struct BenchTraits<PowertrainData> {
+    typedef PowertrainDataPubSubType PubSubType;
+    static bool sized() { return true; }
+    static size_t max_payload() { return 16 * 8; }
+    static void fill(PowertrainData& s, size_t payload) {
+        // sequence<string<8>, 16>: full codes plus one partial code
+        std::vector<eprosima::fastcdr::fixed_string<8>> codes(payload / 8, "xxxxxxxx");
+        if (payload % 8 != 0) codes.push_back(eprosima::fastcdr::fixed_string<8>(std::string(payload % 8, 'x')));
+        s.dtc_codes(std::move(codes));
+    }
+    static void set_id(PowertrainData& s, uint64_t id) { s.timestamp(id); }
+    static uint64_t id(const PowertrainData& s) { return s.timestamp(); }
+};
+
+template<> struct BenchTraits<ChassisData> {
+    typedef ChassisDataPubSubType PubSubType;
+    static bool sized() { return false; }
+    static size_t max_payload() { return 0; }
+    static void fill(ChassisData&, size_t) {}
+    static void set_id(ChassisData& s, uint64_t id) { s.timestamp(id); }
+    static uint64_t id(const ChassisData& s) { return s.timestamp(); }
+};
+
+template<> struct BenchTraits<BatteryData> {
+    typedef BatteryDataPubSubType PubSubType;
+    static bool sized() { return false; }
+    static size_t max_payload() { return 0; }
+    static void fill(BatteryData&, size_t) {}
+    static void set_id(BatteryData& s, uint64_t id) { s.timestamp(id); }
+    static uint64_t id(const BatteryData& s) { return s.timestamp(); }
+};
+
+template<> struct BenchTraits<ADASData> {
+    typedef ADASDataPubSubType PubSubType;
+    static bool sized() { return true; }
+    static size_t max_payload() { return 16 * sizeof(float); }
+    static void fill(ADASData& s, size_t payload) {
+        s.obstacle_distances(std::vector<float>(payload / sizeof(float), 1.0f));
+    }
+    static void set_id(ADASData& s, uint64_t id) { s.timestamp(id); }
+    static uint64_t id(const ADASData& s) { return s.timestamp(); }
+};
+
+template<> struct BenchTraits<TestData> {
+    typedef TestDataPubSubType PubSubType;
+    static bool sized() { return true; }
+    static size_t max_payload() { return 0; }
+    static void fill(TestData& s, size_t payload) { s.message(std::string(payload, 'x')); }
+    static void set_id(TestData& s, uint64_t id) { s.timestamp(id); }
+    static uint64_t id(const TestData& s) { return s.timestamp(); }
+};
+
+template<> struct BenchTraits<SensorData> {
+    typedef SensorDataPubSubType PubSubType;
+    static bool sized() { return true; }
+    static size_t max_payload() { return 0; }
+    static void fill(SensorData& s, size_t payload) { s.message(std::string(payload, 'x')); }
+    static void set_id(SensorData& s, uint64_t id) { s.timestamp(id); }
+    static uint64_t id(const SensorData& s) { return s.timestamp(); }
+};
+
+template<> struct BenchTraits<SteeringCommand> {
+    typedef SteeringCommandPubSubType PubSubType;
+    static bool sized() { return true; }
+    static size_t max_payload() { return 64; }
+    static void fill(SteeringCommand& s, size_t payload) {
+        s.control_reason(eprosima::fastcdr::fixed_string<64>(std::string(payload, 'x')));
+    }
+    static void set_id(SteeringCommand& s, uint64_t id) { s.timestamp(id); }
+    static uint64_t id(const SteeringCommand& s) { return s.timestamp(); }
+};
+
+struct BenchOptions {
+    bool run_latency;
+    bool run_throughput;
+    std::vector<std::string> types;
+    std::vector<size_t> payload_sizes;
+    std::vector<ReliabilityQosPolicyKind> reliabilities;
+    std::vector<HistoryQosPolicyKind> histories;
+    std::vector<TransportKind> transports;
+    int32_t history_depth;
+    uint32_t latency_samples;
+    uint32_t warmup_samples;
+    double throughput_seconds;
+    bool data_sharing;
+    std::string format;
+    std::string output;
+
+    BenchOptions()
+        : run_latency(true)
+        , run_throughput(true)
+        , history_depth(100)
+        , latency_samples(10000)
+        , warmup_samples(100)
+        , throughput_seconds(2.0)
+        , data_sharing(false)
+        , format("csv") {}
+};
+
+struct BenchCase {
+    std::string type;
+    TransportKind transport;
+    ReliabilityQosPolicyKind reliability;
+    HistoryQosPolicyKind history;
+    size_t payload;
+};
+
+struct BenchResult {
+    std::string mode;
+    BenchCase bench_case;
+    uint32_t serialized_size;
+    uint64_t sent;
+    uint64_t received;
+    // latency (one-way estimate = RTT / 2), nanoseconds
+    uint64_t min_ns;
+    double mean_ns;
+    uint64_t p50_ns;
+    uint64_t p99_ns;
+    uint64_t p999_ns;
+    uint64_t max_ns;
+    // throughput
+    double msgs_per_sec;
+    double mbytes_per_sec;
+
+    BenchResult()
+        : serialized_size(0), sent(0), received(0)
+        , min_ns(0), mean_ns(0.0), p50_ns(0), p99_ns(0), p999_ns(0), max_ns(0)
+        , msgs_per_sec(0.0), mbytes_per_sec(0.0) {}
+};
+
+static const char* reliability_name(ReliabilityQosPolicyKind kind) {
+    return kind == RELIABLE_RELIABILITY_QOS ? "reliable" : "best_effort";
+}
+
+static const char* history_name(HistoryQosPolicyKind kind) {
+    return kind == KEEP_ALL_HISTORY_QOS ? "keep_all" : "keep_last";
+}
+
+static uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Runs every benchmark case of one IDL type between a "ping" and a "pong" participant.
+// The pong side echoes ping samples back (latency) or just counts them (throughput).
+template<typename T>
+class TypedBench {
+private:
+    typedef BenchTraits<T> Traits;
+
+    DomainParticipant* ping_participant_;
+    DomainParticipant* pong_participant_;
+    Publisher* ping_publisher_;
+    Subscriber* ping_subscriber_;
+    Publisher* pong_publisher_;
+    Subscriber* pong_subscriber_;
+    Topic* ping_topic_[2];  // [0] on ping participant, [1] on pong participant
+    Topic* pong_topic_[2];
+    TypeSupport type_;
+    const BenchOptions& options_;
+
+    // Echoes every ping sample on the pong writer
+    class EchoListener : public DataReaderListener {
+    public:
+        DataWriter* echo_writer;
+        T sample;
+
+        EchoListener() : echo_writer(nullptr) {}
+
+        void on_data_available(DataReader* reader) override {
+            SampleInfo info;
+            while (reader->take_next_sample(&sample, &info) == ReturnCode_t::RETCODE_OK) {
+                if (info.valid_data && echo_writer != nullptr) {
+                    echo_writer->write(&sample);
+                }
+            }
+        }
+    };
+
+    // Wakes up the ping loop when the echo of the expected id arrives
+    class ReplyListener : public DataReaderListener {
+    public:
+        std::mutex mutex;
+        std::condition_variable cv;
+        uint64_t expected_id;
+        uint64_t received_at_ns;
+        bool received;
+        T sample;
+
+        ReplyListener() : expected_id(0), received_at_ns(0), received(false) {}
+
+        void on_data_available(DataReader* reader) override {
+            SampleInfo info;
+            while (reader->take_next_sample(&sample, &info) == ReturnCode_t::RETCODE_OK) {
+                uint64_t arrival = now_ns();
+                if (!info.valid_data) continue;
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (Traits::id(sample) == expected_id) {
+                    received_at_ns = arrival;
+                    received = true;
+                    cv.notify_one();
+                }
+            }
+        }
+    };
+
+    // Counts received samples for the throughput test
+    class CountListener : public DataReaderListener {
+    public:
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> last_reception_ns;  // now_ns() of the last counted sample
+        T sample;
+
+        CountListener() : count(0), last_reception_ns(0) {}
+
+        void on_data_available(DataReader* reader) override {
+            SampleInfo info;
+            uint64_t taken = 0;
+            while (reader->take_next_sample(&sample, &info) == ReturnCode_t::RETCODE_OK) {
+                if (info.valid_data) taken++;
+            }
+            if (taken > 0) {
+                last_reception_ns = now_ns();
+                count += taken;
+            }
+        }
+    };
+
+    DataWriterQos writer_qos(const BenchCase& c) const {
+        DataWriterQos qos = DATAWRITER_QOS_DEFAULT;
+        qos.reliability().kind = c.reliability;
+        qos.history().kind = c.history;
+        qos.history().depth = options_.history_depth;
+        if (options_.data_sharing) qos.data_sharing().automatic();
+        else qos.data_sharing().off();
+        return qos;
+    }
+
+    DataReaderQos reader_qos(const BenchCase& c) const {
+        DataReaderQos qos = DATAREADER_QOS_DEFAULT;
+        qos.reliability().kind = c.reliability;
+        qos.history().kind = c.history;
+        qos.history().depth = options_.history_depth;
+        if (options_.data_sharing) qos.data_sharing().automatic();
+        else qos.data_sharing().off();
+        return qos;
+    }
+
+    static bool wait_for_match(DataWriter* writer, DataReader* reader) {
+        for (int i = 0; i < 500; ++i) {
+            PublicationMatchedStatus pub_status;
+            SubscriptionMatchedStatus sub_status;
+            writer->get_publication_matched_status(pub_status);
+            reader->get_subscription_matched_status(sub_status);
+            if (pub_status.current_count > 0 && sub_status.current_count > 0) return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+
+    uint32_t serialized_size(T& sample) {
+        return type_->getSerializedSizeProvider(&sample)();
+    }
+
+public:
+    TypedBench(DomainParticipant* ping, DomainParticipant* pong, const std::string& name,
+               const BenchOptions& options)
+        : ping_participant_(ping)
+        , pong_participant_(pong)
+        , type_(new typename Traits::PubSubType())
+        , options_(options) {
+        type_.register_type(ping_participant_);
+        type_.register_type(pong_participant_);
+
+        ping_publisher_ = ping_participant_->create_publisher(PUBLISHER_QOS_DEFAULT);
+        ping_subscriber_ = ping_participant_->create_subscriber(SUBSCRIBER_QOS_DEFAULT);
+        pong_publisher_ = pong_participant_->create_publisher(PUBLISHER_QOS_DEFAULT);
+        pong_subscriber_ = pong_participant_->create_subscriber(SUBSCRIBER_QOS_DEFAULT);
+
+        std::string ping_name = "Bench_" + name + "_Ping";
+        std::string pong_name = "Bench_" + name + "_Pong";
+        ping_topic_[0] = ping_participant_->create_topic(ping_name, type_.get_type_name(), TOPIC_QOS_DEFAULT);
+        ping_topic_[1] = pong_participant_->create_topic(ping_name, type_.get_type_name(), TOPIC_QOS_DEFAULT);
+        pong_topic_[0] = ping_participant_->create_topic(pong_name, type_.get_type_name(), TOPIC_QOS_DEFAULT);
+        pong_topic_[1] = pong_participant_->create_topic(pong_name, type_.get_type_name(), TOPIC_QOS_DEFAULT);
+    }
+
+    ~TypedBench() {
+        ping_participant_->delete_topic(ping_topic_[0]);
+        ping_participant_->delete_topic(pong_topic_[0]);
+        pong_participant_->delete_topic(ping_topic_[1]);
+        pong_participant_->delete_topic(pong_topic_[1]);
+        ping_participant_->delete_publisher(ping_publisher_);
+        ping_participant_->delete_subscriber(ping_subscriber_);
+        pong_participant_->delete_publisher(pong_publisher_);
+        pong_participant_->delete_subscriber(pong_subscriber_);
+        ping_participant_->unregister_type(type_.get_type_name());
+        pong_participant_->unregister_type(type_.get_type_name());
+    }
+
+    bool run_latency(const BenchCase& c, BenchResult& result) {
+        EchoListener echo_listener;
+        ReplyListener reply_listener;
+
+        DataWriter* ping_writer = ping_publisher_->create_datawriter(ping_topic_[0], writer_qos(c));
+        DataReader* ping_reader = pong_subscriber_->create_datareader(ping_topic_[1], reader_qos(c), &echo_listener);
+        DataWriter* pong_writer = pong_publisher_->create_datawriter(pong_topic_[1], writer_qos(c));
+        DataReader* pong_reader = ping_subscriber_->create_datareader(pong_topic_[0], reader_qos(c), &reply_listener);
+        echo_listener.echo_writer = pong_writer;
+
+        bool ok = ping_writer && ping_reader && pong_writer && pong_reader &&
+                  wait_for_match(ping_writer, ping_reader) &&
+                  wait_for_match(pong_writer, pong_reader);
+
+        LatencyHistogram histogram;
+        T sample;
+        Traits::fill(sample, c.payload);
+        result.mode = "latency";
+        result.bench_case = c;
+        result.serialized_size = serialized_size(sample);
+
+        const uint32_t total = options_.warmup_samples + options_.latency_samples;
+        for (uint32_t i = 0; ok && i < total; ++i) {
+            // Ids start at 1 so a default-constructed sample never matches
+            uint64_t id = i + 1;
+            Traits::set_id(sample, id);
+            {
+                std::lock_guard<std::mutex> lock(reply_listener.mutex);
+                reply_listener.expected_id = id;
+                reply_listener.received = false;
+            }
+
+            uint64_t sent_at = now_ns();
+            ping_writer->write(&sample);
+
+            std::unique_lock<std::mutex> lock(reply_listener.mutex);
+            bool received = reply_listener.cv.wait_for(lock, std::chrono::seconds(1),
+                [&reply_listener]() { return reply_listener.received; });
+
+            if (i < options_.warmup_samples) continue;
+            result.sent++;
+            if (received) {
+                result.received++;
+                histogram.record((reply_listener.received_at_ns - sent_at) / 2);
+            }
+        }
+
+        result.min_ns = histogram.min();
+        result.mean_ns = histogram.mean();
+        result.p50_ns = histogram.percentile(50.0);
+        result.p99_ns = histogram.percentile(99.0);
+        result.p999_ns = histogram.percentile(99.9);
+        result.max_ns = histogram.max();
+
+        echo_listener.echo_writer = nullptr;
+        if (pong_reader) ping_subscriber_->delete_datareader(pong_reader);
+        if (ping_reader) pong_subscriber_->delete_datareader(ping_reader);
+        if (pong_writer) pong_publisher_->delete_datawriter(pong_writer);
+        if (ping_writer) ping_publisher_->delete_datawriter(ping_writer);
+        return ok;
+    }
+
+    bool run_throughput(const BenchCase& c, BenchResult& result) {
+        CountListener count_listener;
+
+        DataWriter* writer = ping_publisher_->create_datawriter(ping_topic_[0], writer_qos(c));
+        DataReader* reader = pong_subscriber_->create_datareader(ping_topic_[1], reader_qos(c), &count_listener);
+        bool ok = writer && reader && wait_for_match(writer, reader);
+
+        T sample;
+        Traits::fill(sample, c.payload);
+        result.mode = "throughput";
+        result.bench_case = c;
+        result.serialized_size = serialized_size(sample);
+
+        if (ok) {
+            const uint64_t duration_ns = static_cast<uint64_t>(options_.throughput_seconds * 1e9);
+            const uint64_t start = now_ns();
+            uint64_t id = 1;
+            while (now_ns() - start < duration_ns) {
+                Traits::set_id(sample, id++);
+                if (writer->write(&sample)) {
+                    result.sent++;
+                }
+            }
+            const uint64_t send_end = now_ns();
+
+            // Drain: wait until the reader stops making progress
+            uint64_t last = count_listener.count;
+            for (int idle = 0; idle < 5 && last < result.sent; ) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                uint64_t current = count_listener.count;
+                idle = (current == last) ? idle + 1 : 0;
+                last = current;
+            }
+            // The idle drain periods are not part of the run: it lasts until the
+            // later of the end of sending and the last reception
+            const uint64_t end = std::max(send_end, count_listener.last_reception_ns.load());
+            const double elapsed = (end - start) / 1e9;
+
+            result.received = count_listener.count;
+            result.msgs_per_sec = result.received / elapsed;
+            result.mbytes_per_sec = result.received * static_cast<double>(result.serialized_size) / elapsed / 1e6;
+        }
+
+        if (reader) pong_subscriber_->delete_datareader(reader);
+        if (writer) ping_publisher_->delete_datawriter(writer);
+        return ok;
+    }
+};
+
+template<typename T>
+void run_type_bench(DomainParticipant* ping, DomainParticipant* pong, const std::string& name,
+                    TransportKind transport, const BenchOptions& options,
+                    std::vector<BenchResult>& results) {
+    TypedBench<T> bench(ping, pong, name, options);
+
+    // Fixed-size types have a single payload size; bounded types are capped
+    // at their bound (larger sizes collapse into one run at the bound)
+    std::vector<size_t> sizes;
+    if (BenchTraits<T>::sized()) {
+        size_t bound = BenchTraits<T>::max_payload();
+        for (auto payload : options.payload_sizes) {
+            if (bound != 0 && payload > bound) payload = bound;
+            if (std::find(sizes.begin(), sizes.end(), payload) == sizes.end()) sizes.push_back(payload);
+        }
+    } else {
+        sizes.push_back(0);
+    }
+
+    for (auto reliability : options.reliabilities) {
+        for (auto history : options.histories) {
+            for (auto payload : sizes) {
+                BenchCase c = {name, transport, reliability, history, payload};
+                std::cerr << "[" << name << " " << transport_kind_name(transport) << " "
+                          << reliability_name(reliability) << " " << history_name(history)
+                          << " " << payload << "B]" << std::endl;
+
+                if (options.run_latency) {
+                    BenchResult result;
+                    if (!bench.run_latency(c, result)) std::cerr << "  latency: endpoints did not match" << std::endl;
+                    results.push_back(result);
+                }
+                if (options.run_throughput) {
+                    BenchResult result;
+                    if (!bench.run_throughput(c, result)) std::cerr << "  throughput: endpoints did not match" << std::endl;
+                    results.push_back(result);
+                }
+            }
+        }
+    }
+}
+
+typedef std::function<void(DomainParticipant*, DomainParticipant*, TransportKind,
+                           const BenchOptions&, std::vector<BenchResult>&)> BenchRunner;
+
+static std::map<std::string, BenchRunner> bench_registry() {
+    std::map<std::string, BenchRunner> registry;
+#define REGISTER_BENCH(cli_name, Type) \
+    registry[cli_name] = [](DomainParticipant* ping, DomainParticipant* pong, TransportKind transport, \
+                            const BenchOptions& options, std::vector<BenchResult>& results) { \
+        run_type_bench<Type>(ping, pong, #Type, transport, options, results); \
+    }
+    REGISTER_BENCH("hello", HelloWorld);
+    REGISTER_BENCH("domain", DomainTest);
+    REGISTER_BENCH("diagnostics", VehicleDiagnostics);
+    REGISTER_BENCH("powertrain", PowertrainData);
+    REGISTER_BENCH("chassis", ChassisData);
+    REGISTER_BENCH("battery", BatteryData);
+    REGISTER_BENCH("adas", ADASData);
+    REGISTER_BENCH("testdata", TestData);
+    REGISTER_BENCH("sensor", SensorData);
+    REGISTER_BENCH("steering", SteeringCommand);
+#undef REGISTER_BENCH
+    return registry;
+}
+
+static void write_csv(std::ostream& out, const std::vector<BenchResult>& results) {
+    out << "mode,type,transport,reliability,history,payload,serialized_size,sent,received,"
+        << "min_ns,mean_ns,p50_ns,p99_ns,p999_ns,max_ns,msgs_per_sec,mbytes_per_sec\n";
+    for (const auto& r : results) {
+        out << r.mode << ',' << r.bench_case.type << ',' << transport_kind_name(r.bench_case.transport) << ','
+            << reliability_name(r.bench_case.reliability) << ',' << history_name(r.bench_case.history) << ','
+            << r.bench_case.payload << ',' << r.serialized_size << ',' << r.sent << ',' << r.received << ','
+            << r.min_ns << ',' << r.mean_ns << ',' << r.p50_ns << ',' << r.p99_ns << ',' << r.p999_ns << ','
+            << r.max_ns << ',' << r.msgs_per_sec << ',' << r.mbytes_per_sec << '\n';
+    }
+}
+
+static void write_json(std::ostream& out, const std::vector<BenchResult>& results) {
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        out << "  {\"mode\": \"" << r.mode << "\", \"type\": \"" << r.bench_case.type
+            << "\", \"transport\": \"" << transport_kind_name(r.bench_case.transport)
+            << "\", \"reliability\": \"" << reliability_name(r.bench_case.reliability)
+            << "\", \"history\": \"" << history_name(r.bench_case.history)
+            << "\", \"payload\": " << r.bench_case.payload
+            << ", \"serialized_size\": " << r.serialized_size
+            << ", \"sent\": " << r.sent << ", \"received\": " << r.received
+            << ", \"min_ns\": " << r.min_ns << ", \"mean_ns\": " << r.mean_ns
+            << ", \"p50_ns\": " << r.p50_ns << ", \"p99_ns\": " << r.p99_ns
+            << ", \"p999_ns\": " << r.p999_ns << ", \"max_ns\": " << r.max_ns
+            << ", \"msgs_per_sec\": " << r.msgs_per_sec << ", \"mbytes_per_sec\": " << r.mbytes_per_sec
+            << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+}
+
+static std::vector<std::string> split(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+static void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --mode <latency|throughput|all>           (default: all)\n"
+              << "  --types <hello,domain,diagnostics,powertrain,chassis,battery,\n"
+              << "           adas,testdata,sensor,steering|all> (default: all)\n"
+              << "  --sizes <bytes,...>                        (default: 16,256,4096)\n"
+              << "  --reliability <reliable,best_effort>       (default: both)\n"
+              << "  --history <keep_last,keep_all>             (default: both)\n"
+              << "  --depth <n>                                KEEP_LAST depth (default: 100)\n"
+              << "  --transports <default,shm,udp,shm+udp>     (default: shm,udp)\n"
+              << "  --samples <n>                              latency samples (default: 10000)\n"
+              << "  --warmup <n>                               discarded latency samples (default: 100)\n"
+              << "  --duration <seconds>                       throughput run time (default: 2)\n"
+              << "  --data-sharing                             enable data-sharing delivery\n"
+              << "  --format <csv|json>                        (default: csv)\n"
+              << "  --output <file>                            (default: stdout)\n";
+}
+
+static bool parse_options(int argc, char** argv, BenchOptions& options) {
+    std::vector<std::string> transports = {"shm", "udp"};
+    std::vector<std::string> reliabilities = {"reliable", "best_effort"};
+    std::vector<std::string> histories = {"keep_last", "keep_all"};
+    std::vector<std::string> sizes = {"16", "256", "4096"};
+    options.types.clear();
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--data-sharing") {
+            options.data_sharing = true;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+
+        if (arg == "--mode") {
+            if (value != "latency" && value != "throughput" && value != "all") return false;
+            options.run_latency = (value == "latency" || value == "all");
+            options.run_throughput = (value == "throughput" || value == "all");
+        }
+        else if (arg == "--types") options.types = split(value);
+        else if (arg == "--sizes") sizes = split(value);
+        else if (arg == "--reliability") reliabilities = split(value);
+        else if (arg == "--history") histories = split(value);
+        else if (arg == "--depth") options.history_depth = std::atoi(value.c_str());
+        else if (arg == "--transports") transports = split(value);
+        else if (arg == "--samples") options.latency_samples = static_cast<uint32_t>(std::atoi(value.c_str()));
+        else if (arg == "--warmup") options.warmup_samples = static_cast<uint32_t>(std::atoi(value.c_str()));
+        else if (arg == "--duration") options.throughput_seconds = std::atof(value.c_str());
+        else if (arg == "--format") options.format = value;
+        else if (arg == "--output") options.output = value;
+        else return false;
+    }
+
+    if (options.types.empty() || (options.types.size() == 1 && options.types[0] == "all")) {
+        options.types = {"hello", "domain", "diagnostics", "powertrain", "chassis",
+                         "battery", "adas", "testdata", "sensor", "steering"};
+    }
+    for (const auto& s : sizes) {
+        options.payload_sizes.push_back(static_cast<size_t>(std::strtoul(s.c_str(), nullptr, 10)));
+    }
+    for (const auto& r : reliabilities) {
+        if (r == "reliable") options.reliabilities.push_back(RELIABLE_RELIABILITY_QOS);
+        else if (r == "best_effort") options.reliabilities.push_back(BEST_EFFORT_RELIABILITY_QOS);
+        else return false;
+    }
+    for (const auto& h : histories) {
+        if (h == "keep_last") options.histories.push_back(KEEP_LAST_HISTORY_QOS);
+        else if (h == "keep_all") options.histories.push_back(KEEP_ALL_HISTORY_QOS);
+        else return false;
+    }
+    for (const auto& t : transports) {
+        TransportKind kind;
+        if (!parse_transport_kind(t, kind)) return false;
+        options.transports.push_back(kind);
+    }
+    return options.format == "csv" || options.format == "json";
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parse_options(argc, argv, options)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    // Both participants live in this process; disable intraprocess delivery
+    // so samples actually go through the selected transport.
+    eprosima::fastrtps::LibrarySettingsAttributes library_settings;
+    library_settings.intraprocess_delivery = eprosima::fastrtps::INTRAPROCESS_OFF;
+    eprosima::fastrtps::xmlparser::XMLProfileManager::library_settings(library_settings);
+
+    std::map<std::string, BenchRunner> registry = bench_registry();
+    std::vector<BenchResult> results;
+
+    for (auto transport_kind : options.transports) {
+        TransportOptions transport;
+        transport.kind = transport_kind;
+
+        DomainParticipantQos ping_qos;
+        ping_qos.name("DDSBench_Ping");
+        apply_transport(ping_qos, transport);
+        DomainParticipantQos pong_qos;
+        pong_qos.name("DDSBench_Pong");
+        apply_transport(pong_qos, transport);
+
+        DomainParticipant* ping = DomainParticipantFactory::get_instance()->create_participant(0, ping_qos);
+        DomainParticipant* pong = DomainParticipantFactory::get_instance()->create_participant(0, pong_qos);
+        if (ping == nullptr || pong == nullptr) {
+            std::cerr << "Failed to create participants for transport "
+                      << transport_kind_name(transport_kind) << std::endl;
+            return 1;
+        }
+
+        for (const auto& type : options.types) {
+            auto it = registry.find(type);
+            if (it == registry.end()) {
+                std::cerr << "Unknown type: " << type << std::endl;
+                continue;
+            }
+            it->second(ping, pong, transport_kind, options, results);
+        }
+
+        DomainParticipantFactory::get_instance()->delete_participant(ping);
+        DomainParticipantFactory::get_instance()->delete_participant(pong);
+    }
+
+    if (options.output.empty()) {
+        if (options.format == "json") write_json(std::cout, results);
+        else write_csv(std::cout, results);
+    } else {
+        std::ofstream out(options.output);
+        if (options.format == "json") write_json(out, results);
+        else write_csv(out, results);
+        std::cerr << "Results written to " << options.output << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,391 @@
+#include "SteeringControl.h"
+#include "SteeringControlPubSubTypes.h"
+#include "SteeringQos.hpp"
+#include "BatchTake.hpp"
+#include "LatencyHistogram.hpp"
+#include "PeriodicScheduler.hpp"
+#include "TransportConfig.hpp"
+
+#include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastdds/dds/domain/DomainParticipant.hpp>
+#include <fastdds/dds/topic/TypeSupport.hpp>
+#include <fastdds/dds/publisher/Publisher.hpp>
+#include <fastdds/dds/publisher/DataWriter.hpp>
+#include <fastdds/dds/publisher/qos/DataWriterQos.hpp>
+#include <fastdds/dds/subscriber/Subscriber.hpp>
+#include <fastdds/dds/subscriber/DataReader.hpp>
+#include <fastdds/dds/subscriber/DataReaderListener.hpp>
+#include <fastdds/dds/subscriber/qos/DataReaderQos.hpp>
+#include <fastrtps/xmlparser/XMLProfileManager.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+using namespace eprosima::fastdds::dds;
+
+// Exclusive-ownership failover time on the SteeringControl topic. The reader
+// and a backup controller (strength 20) run in this process; the owner
+// (strength 30) runs in a child process started from this binary. Once the
+// reader receives the owner's commands, the child is killed with SIGKILL, so
+// it leaves without unregistering or saying goodbye, like a crashed ECU.
+//
+// Time-to-takeover runs from the kill to the first backup command delivered
+// to the reader. It is bounded by the liveliness lease (AUTOMATIC: the dead
+// participant stops announcing; MANUAL_BY_TOPIC: the dead writer stops
+// writing) plus one backup publish period. With an infinite lease only the
+// participant lease (20 s by default) detects the dead owner.
+// Liveliness-lost and deadline-missed times show which event came first.
+
+static const uint32_t kOwnerStrength = 30;
+static const uint32_t kBackupStrength = 20;
+
+struct FailoverOptions {
+    uint32_t trials;
+    double rate;          // commands per second of both controllers
+    double timeout;       // seconds to wait for a takeover
+    SteeringTiming timing;
+    TransportOptions transport;
+
+    FailoverOptions()
+        : trials(10)
+        , rate(1000.0)
+        , timeout(30.0) {}
+};
+
+static int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Steering controller writing commands at a fixed rate in its own participant
+class Controller {
+private:
+    DomainParticipant* participant_;
+    Publisher* publisher_;
+    Topic* topic_;
+    DataWriter* writer_;
+    TypeSupport type_;
+    std::atomic<bool> running_;
+    std::thread thread_;
+
+public:
+    Controller()
+        : participant_(nullptr)
+        , publisher_(nullptr)
+        , topic_(nullptr)
+        , writer_(nullptr)
+        , type_(new SteeringCommandPubSubType())
+        , running_(false) {}
+
+    ~Controller() {
+        stop();
+        if (participant_ != nullptr) {
+            if (writer_ != nullptr) publisher_->delete_datawriter(writer_);
+            if (publisher_ != nullptr) participant_->delete_publisher(publisher_);
+            if (topic_ != nullptr) participant_->delete_topic(topic_);
+            DomainParticipantFactory::get_instance()->delete_participant(participant_);
+        }
+    }
+
+    bool init(const std::string& name, uint32_t strength, const FailoverOptions& options) {
+        DomainParticipantQos participant_qos;
+        participant_qos.name("FailoverBench_" + name);
+        apply_transport(participant_qos, options.transport);
+        participant_ = DomainParticipantFactory::get_instance()->create_participant(0, participant_qos);
+        if (participant_ == nullptr) return false;
+
+        type_.register_type(participant_);
+        publisher_ = participant_->create_publisher(PUBLISHER_QOS_DEFAULT);
+        topic_ = participant_->create_topic("SteeringControl", "SteeringCommand", TOPIC_QOS_DEFAULT);
+        if (publisher_ == nullptr || topic_ == nullptr) return false;
+
+        DataWriterQos qos = DATAWRITER_QOS_DEFAULT;
+        qos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+        qos.ownership().kind = EXCLUSIVE_OWNERSHIP_QOS;
+        qos.ownership_strength().value = strength;
+        apply_steering_timing(qos, options.timing);
+        writer_ = publisher_->create_datawriter(topic_, qos);
+        return writer_ != nullptr;
+    }
+
+    InstanceHandle_t handle() const { return writer_->get_instance_handle(); }
+
+    // Writes until stop()
+    void run(const std::string& name, double rate) {
+        SteeringCommand command;
+        command.controller_name(eprosima::fastcdr::fixed_string<32>(name));
+        command.control_reason("Failover benchmark");
+        PeriodicTimer timer(PeriodicTimer::period_from_rate(rate));
+        while (running_) {
+            command.timestamp(std::chrono::system_clock::now().time_since_epoch().count());
+            writer_->write(&command);
+            timer.wait();
+        }
+    }
+
+    void start(const std::string& name, double rate) {
+        running_ = true;
+        thread_ = std::thread([this, name, rate]() { run(name, rate); });
+    }
+
+    void stop() {
+        running_ = false;
+        if (thread_.joinable()) thread_.join();
+    }
+};
+
+// Tells the owner's commands from the backup's by publication handle and
+// timestamps the failover events of the current trial (steady clock, ns)
+class FailoverListener : public DataReaderListener {
+public:
+    InstanceHandle_t backup;
+    std::atomic<uint64_t> owner_samples;
+    std::atomic<bool> armed;             // the owner is being killed
+    std::atomic<int64_t> first_backup_ns;
+    std::atomic<int64_t> liveliness_lost_ns;
+    std::atomic<int64_t> deadline_missed_ns;
+
+    FailoverListener()
+        : owner_samples(0)
+        , armed(false)
+        , first_backup_ns(0)
+        , liveliness_lost_ns(0)
+        , deadline_missed_ns(0) {}
+
+    void reset() {
+        armed = false;
+        owner_samples = 0;
+        first_backup_ns = 0;
+        liveliness_lost_ns = 0;
+        deadline_missed_ns = 0;
+    }
+
+    void on_data_available(DataReader* reader) override {
+        take_batches<SteeringCommand>(reader, kDefaultMaxBatch, [this](const SteeringCommand&, const SampleInfo& info) {
+            if (!(info.publication_handle == backup)) {
+                owner_samples++;
+            } else if (armed && first_backup_ns == 0) {
+                first_backup_ns = now_ns();
+            }
+        });
+    }
+
+    void on_liveliness_changed(DataReader*, const LivelinessChangedStatus& status) override {
+        if (armed && status.not_alive_count_change > 0 && liveliness_lost_ns == 0) {
+            liveliness_lost_ns = now_ns();
+        }
+    }
+
+    void on_requested_deadline_missed(DataReader*, const RequestedDeadlineMissedStatus&) override {
+        if (armed && deadline_missed_ns == 0) {
+            deadline_missed_ns = now_ns();
+        }
+    }
+};
+
+// Starts this binary again as the owner controller
+static pid_t spawn_owner(const std::vector<std::string>& args) {
+    std::vector<char*> child_argv;
+    for (const auto& arg : args) child_argv.push_back(const_cast<char*>(arg.c_str()));
+    child_argv.push_back(nullptr);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+#ifdef __linux__
+        execv("/proc/self/exe", child_argv.data());
+#endif
+        execvp(child_argv[0], child_argv.data());
+        _exit(127);
+    }
+    return pid;
+}
+
+static void kill_owner(pid_t pid) {
+    kill(pid, SIGKILL);
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+
+static bool wait_until(const std::atomic<int64_t>& value, double seconds) {
+    int64_t limit = now_ns() + static_cast<int64_t>(seconds * 1e9);
+    while (value == 0 && now_ns() < limit) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return value != 0;
+}
+
+static int run_owner(const FailoverOptions& options) {
+#ifdef __linux__
+    // Do not outlive the benchmark
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+    Controller owner;
+    if (!owner.init("Owner", kOwnerStrength, options)) return 1;
+    // Writes until the benchmark kills this process
+    owner.start("Emergency Controller", options.rate);
+    while (true) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+}
+
+static void print_row(const char* name, const LatencyHistogram& histogram) {
+    if (histogram.count() == 0) {
+        std::cout << "  " << name << ": -\n";
+        return;
+    }
+    std::cout << "  " << name << ": p50 " << histogram.percentile(50.0) / 1000
+              << " us, p99 " << histogram.percentile(99.0) / 1000
+              << " us, max " << histogram.max() / 1000 << " us (" << histogram.count() << " trials)\n";
+}
+
+static void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --trials <n>                    : Owner kills (default 10)\n"
+              << "  --rate <hz>                     : Command rate of both controllers (default 1000)\n"
+              << "  --timeout <s>                   : Longest wait for a takeover (default 30)\n"
+              << steering_timing_usage()
+              << transport_usage();
+}
+
+int main(int argc, char** argv) {
+    FailoverOptions options;
+    bool child = false;
+    std::vector<std::string> child_args = {argv[0], "--child"};
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--child") {
+            child = true;
+            continue;
+        }
+        int first = i;
+        if (arg == "--trials" && i + 1 < argc) {
+            options.trials = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--rate" && i + 1 < argc) {
+            options.rate = std::atof(argv[++i]);
+        } else if (arg == "--timeout" && i + 1 < argc) {
+            options.timeout = std::atof(argv[++i]);
+        } else if (!parse_steering_timing_arg(argc, argv, i, options.timing) &&
+                   !parse_transport_arg(argc, argv, i, options.transport)) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        for (int j = first; j <= i; ++j) child_args.push_back(argv[j]);
+    }
+    if (options.rate <= 0.0 || options.trials == 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (child) {
+        return run_owner(options);
+    }
+
+    // The backup and the reader share this process; disable intraprocess
+    // delivery so the backup's commands go through the transport as well
+    eprosima::fastrtps::LibrarySettingsAttributes library_settings;
+    library_settings.intraprocess_delivery = eprosima::fastrtps::INTRAPROCESS_OFF;
+    eprosima::fastrtps::xmlparser::XMLProfileManager::library_settings(library_settings);
+
+    Controller backup;
+    if (!backup.init("Backup", kBackupStrength, options)) {
+        std::cerr << "Failed to create the backup controller" << std::endl;
+        return 1;
+    }
+
+    DomainParticipantQos participant_qos;
+    participant_qos.name("FailoverBench_Reader");
+    apply_transport(participant_qos, options.transport);
+    DomainParticipant* participant = DomainParticipantFactory::get_instance()->create_participant(0, participant_qos);
+    if (participant == nullptr) return 1;
+    TypeSupport type(new SteeringCommandPubSubType());
+    type.register_type(participant);
+    Topic* topic = participant->create_topic("SteeringControl", "SteeringCommand", TOPIC_QOS_DEFAULT);
+    Subscriber* subscriber = participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT);
+
+    DataReaderQos reader_qos = DATAREADER_QOS_DEFAULT;
+    reader_qos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+    reader_qos.ownership().kind = EXCLUSIVE_OWNERSHIP_QOS;
+    apply_steering_timing(reader_qos, options.timing);
+    FailoverListener listener;
+    listener.backup = backup.handle();
+    DataReader* reader = subscriber->create_datareader(topic, reader_qos, &listener);
+    if (reader == nullptr) return 1;
+
+    backup.start("ADAS Controller", options.rate);
+
+    std::cerr << "Liveliness " << liveliness_kind_name(options.timing.liveliness)
+              << ", lease " << options.timing.lease_ms << " ms, deadline " << options.timing.deadline_ms
+              << " ms, " << options.rate << " commands/s" << std::endl;
+
+    LatencyHistogram takeover;
+    LatencyHistogram liveliness_lost;
+    LatencyHistogram deadline_missed;
+    uint32_t failed = 0;
+    for (uint32_t trial = 0; trial < options.trials; ++trial) {
+        listener.reset();
+        pid_t pid = spawn_owner(child_args);
+        if (pid < 0) {
+            std::cerr << "fork failed" << std::endl;
+            break;
+        }
+
+        // Wait until the owner's commands arrive, then let it own for a while
+        int64_t limit = now_ns() + 10000000000LL;
+        while (listener.owner_samples == 0 && now_ns() < limit) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (listener.owner_samples == 0) {
+            std::cerr << "  trial " << trial + 1 << ": the owner never took over" << std::endl;
+            kill_owner(pid);
+            failed++;
+            continue;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+        listener.armed = true;
+        int64_t killed_at = now_ns();
+        kill_owner(pid);
+
+        if (!wait_until(listener.first_backup_ns, options.timeout)) {
+            std::cerr << "  trial " << trial + 1 << ": no takeover within " << options.timeout << " s" << std::endl;
+            failed++;
+            continue;
+        }
+        uint64_t takeover_ns = static_cast<uint64_t>(listener.first_backup_ns - killed_at);
+        takeover.record(takeover_ns);
+        if (listener.liveliness_lost_ns != 0) {
+            liveliness_lost.record(static_cast<uint64_t>(listener.liveliness_lost_ns - killed_at));
+        }
+        if (listener.deadline_missed_ns != 0) {
+            deadline_missed.record(static_cast<uint64_t>(listener.deadline_missed_ns - killed_at));
+        }
+        std::cerr << "  trial " << trial + 1 << ": takeover " << takeover_ns / 1000 << " us" << std::endl;
+    }
+
+    std::cout << "Failover after SIGKILL of the owner (liveliness " << liveliness_kind_name(options.timing.liveliness)
+              << ", lease " << options.timing.lease_ms << " ms, deadline " << options.timing.deadline_ms << " ms):\n";
+    print_row("time to takeover", takeover);
+    print_row("liveliness lost", liveliness_lost);
+    print_row("deadline missed", deadline_missed);
+    if (failed > 0) std::cout << "  failed trials: " << failed << "\n";
+
+    backup.stop();
+    subscriber->delete_datareader(reader);
+    participant->delete_subscriber(subscriber);
+    participant->delete_topic(topic);
+    DomainParticipantFactory::get_instance()->delete_participant(participant);
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,394 @@
+#include "VehicleSystemsPubSubTypes.h"
+#include "VehicleSystemsFilter.hpp"
+#include "BatchTake.hpp"
+#include "TransportConfig.hpp"
+
+#include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastdds/dds/domain/DomainParticipant.hpp>
+#include <fastdds/dds/topic/TypeSupport.hpp>
+#include <fastdds/dds/topic/ContentFilteredTopic.hpp>
+#include <fastdds/dds/publisher/Publisher.hpp>
+#include <fastdds/dds/publisher/DataWriter.hpp>
+#include <fastdds/dds/publisher/qos/DataWriterQos.hpp>
+#include <fastdds/dds/subscriber/Subscriber.hpp>
+#include <fastdds/dds/subscriber/DataReader.hpp>
+#include <fastdds/dds/subscriber/DataReaderListener.hpp>
+#include <fastdds/dds/subscriber/qos/DataReaderQos.hpp>
+#include <fastrtps/xmlparser/XMLProfileManager.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastdds::dds;
+
+// Bandwidth saved by content filtering on the writer side. Every case
+// publishes the same random VehicleSystems samples to a reader on a
+// ContentFilteredTopic twice: once with writer-side filtering (the writer
+// evaluates the reader's filter and does not send the samples that fail)
+// and once with reader-side filtering only (every sample crosses the
+// transport and is dropped on receive). Sent samples and payload bytes come
+// from the filter counters of each side; RTPS headers, heartbeats and the
+// GAPs announcing filtered samples are not included.
+
+// Per-type sample generators, the value ranges of VehicleSystemsPublisher
+template<typename T> struct FilterBenchTraits;
+
+template<> struct FilterBenchTraits<PowertrainData> {
+    typedef PowertrainDataPubSubType PubSubType;
+    static void randomize(PowertrainData& d, std::mt19937& gen) {
+        d.engine_rpm(std::uniform_real_distribution<float>(800.0f, 3000.0f)(gen));
+        d.engine_temperature(std::uniform_real_distribution<float>(75.0f, 95.0f)(gen));
+        d.engine_load(std::uniform_real_distribution<float>(0.0f, 100.0f)(gen));
+        d.transmission_temp(std::uniform_real_distribution<float>(70.0f, 90.0f)(gen));
+        d.current_gear(std::uniform_int_distribution<int>(1, 6)(gen));
+        d.throttle_position(std::uniform_real_distribution<float>(0.0f, 100.0f)(gen));
+    }
+};
+
+template<> struct FilterBenchTraits<ChassisData> {
+    typedef ChassisDataPubSubType PubSubType;
+    static void randomize(ChassisData& d, std::mt19937& gen) {
+        d.brake_pressure(std::uniform_real_distribution<float>(0.0f, 100.0f)(gen));
+        d.steering_angle(std::uniform_real_distribution<float>(-30.0f, 30.0f)(gen));
+        for (int i = 0; i < 4; i++) {
+            d.suspension_height()[i] = std::uniform_real_distribution<float>(150.0f, 200.0f)(gen);
+            d.wheel_speed()[i] = std::uniform_real_distribution<float>(0.0f, 120.0f)(gen);
+            d.brake_pad_wear()[i] = std::uniform_real_distribution<float>(0.0f, 100.0f)(gen);
+        }
+        d.abs_active(std::uniform_real_distribution<float>(0.0f, 1.0f)(gen) < 0.1f);
+        d.traction_control_active(std::uniform_real_distribution<float>(0.0f, 1.0f)(gen) < 0.1f);
+    }
+};
+
+template<> struct FilterBenchTraits<BatteryData> {
+    typedef BatteryDataPubSubType PubSubType;
+    static void randomize(BatteryData& d, std::mt19937& gen) {
+        d.voltage(std::uniform_real_distribution<float>(11.0f, 14.4f)(gen));
+        d.current(std::uniform_real_distribution<float>(-20.0f, 100.0f)(gen));
+        d.temperature(std::uniform_real_distribution<float>(20.0f, 40.0f)(gen));
+        d.state_of_charge(std::uniform_real_distribution<float>(0.0f, 100.0f)(gen));
+        d.power_consumption(std::uniform_real_distribution<float>(0.0f, 3000.0f)(gen));
+        d.charging_cycles(std::uniform_int_distribution<int>(0, 1000)(gen));
+        d.charging_status(std::uniform_real_distribution<float>(0.0f, 1.0f)(gen) < 0.2f);
+    }
+};
+
+template<> struct FilterBenchTraits<ADASData> {
+    typedef ADASDataPubSubType PubSubType;
+    static void randomize(ADASData& d, std::mt19937& gen) {
+        d.forward_collision_distance(std::uniform_real_distribution<float>(0.0f, 100.0f)(gen));
+        d.lane_deviation(std::uniform_real_distribution<float>(-1.0f, 1.0f)(gen));
+        d.lane_departure_warning(std::uniform_real_distribution<float>(0.0f, 1.0f)(gen) < 0.1f);
+        d.forward_collision_warning(std::uniform_real_distribution<float>(0.0f, 1.0f)(gen) < 0.1f);
+        d.blind_spot_warning_left(std::uniform_real_distribution<float>(0.0f, 1.0f)(gen) < 0.1f);
+        d.blind_spot_warning_right(std::uniform_real_distribution<float>(0.0f, 1.0f)(gen) < 0.1f);
+        d.obstacle_distances().resize(std::uniform_int_distribution<int>(1, 3)(gen));
+        for (auto& distance : d.obstacle_distances()) {
+            distance = std::uniform_real_distribution<float>(1.0f, 50.0f)(gen);
+        }
+        d.adaptive_cruise_speed(std::uniform_real_distribution<float>(0.0f, 120.0f)(gen));
+        d.time_to_collision(std::uniform_real_distribution<float>(0.0f, 10.0f)(gen));
+    }
+};
+
+struct FilterCase {
+    std::string topic;       // powertrain, chassis, battery, adas
+    std::string expression;
+};
+
+struct FilterBenchOptions {
+    uint32_t samples;
+    TransportOptions transport;
+    std::vector<FilterCase> cases;
+    std::string output;
+
+    FilterBenchOptions() : samples(10000) {
+        transport.kind = TransportKind::UDP;
+    }
+};
+
+struct FilterResult {
+    FilterCase filter_case;
+    bool writer_side;
+    uint64_t published;
+    uint64_t delivered;
+    uint64_t sent_samples;     // samples that crossed the transport
+    uint64_t sent_bytes;       // their serialized payload
+    uint64_t offered_bytes;    // payload of every published sample
+    uint64_t reader_evaluated; // samples the reader had to filter itself
+    double seconds;
+
+    FilterResult()
+        : writer_side(false), published(0), delivered(0), sent_samples(0), sent_bytes(0)
+        , offered_bytes(0), reader_evaluated(0), seconds(0.0) {}
+};
+
+struct CounterSnapshot {
+    uint64_t evaluated;
+    uint64_t passed;
+    uint64_t evaluated_bytes;
+    uint64_t passed_bytes;
+
+    explicit CounterSnapshot(const VehicleFilterCounters& c)
+        : evaluated(c.evaluated.load())
+        , passed(c.passed.load())
+        , evaluated_bytes(c.evaluated_bytes.load())
+        , passed_bytes(c.passed_bytes.load()) {}
+};
+
+template<typename T>
+class CountListener : public DataReaderListener {
+public:
+    std::atomic<uint64_t> count;
+
+    CountListener() : count(0) {}
+
+    void on_data_available(DataReader* reader) override {
+        count += take_batches<T>(reader, kDefaultMaxBatch, [](const T&, const SampleInfo&) {});
+    }
+};
+
+static bool wait_for_match(DataWriter* writer, DataReader* reader) {
+    for (int i = 0; i < 500; ++i) {
+        PublicationMatchedStatus pub_status;
+        SubscriptionMatchedStatus sub_status;
+        writer->get_publication_matched_status(pub_status);
+        reader->get_subscription_matched_status(sub_status);
+        if (pub_status.current_count > 0 && sub_status.current_count > 0) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+// One filter case in one mode. The writer and the reader are in different
+// participants, each with its own filter factory, so the counters tell the
+// writer's evaluations from the reader's.
+template<typename T>
+static bool run_filter_case(DomainParticipant* writer_participant, VehicleFilterFactory& writer_factory,
+                            DomainParticipant* reader_participant, VehicleFilterFactory& reader_factory,
+                            const FilterCase& c, bool writer_side, uint32_t samples, FilterResult& result) {
+    TypeSupport type(new typename FilterBenchTraits<T>::PubSubType());
+    type.register_type(writer_participant);
+    type.register_type(reader_participant);
+    const std::string type_name = type.get_type_name();
+
+    std::string topic_name = "FilterBench_" + c.topic;
+    Topic* writer_topic = writer_participant->create_topic(topic_name, type_name, TOPIC_QOS_DEFAULT);
+    Topic* reader_topic = reader_participant->create_topic(topic_name, type_name, TOPIC_QOS_DEFAULT);
+    ContentFilteredTopic* filtered = reader_topic == nullptr ? nullptr :
+        reader_participant->create_contentfilteredtopic(topic_name + "_Filtered", reader_topic,
+                                                        c.expression, {}, kVehicleFilterClass);
+    Publisher* publisher = writer_participant->create_publisher(PUBLISHER_QOS_DEFAULT);
+    Subscriber* subscriber = reader_participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT);
+
+    // Reliable KEEP_ALL, so both modes deliver every matching sample. Writer-side
+    // filtering needs room for the reader's filter and no data-sharing.
+    DataWriterQos writer_qos = DATAWRITER_QOS_DEFAULT;
+    writer_qos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+    writer_qos.history().kind = KEEP_ALL_HISTORY_QOS;
+    writer_qos.data_sharing().off();
+    writer_qos.writer_resource_limits().reader_filters_allocation.initial = 0;
+    writer_qos.writer_resource_limits().reader_filters_allocation.maximum = writer_side ? 1 : 0;
+    DataReaderQos reader_qos = DATAREADER_QOS_DEFAULT;
+    reader_qos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+    reader_qos.history().kind = KEEP_ALL_HISTORY_QOS;
+    reader_qos.data_sharing().off();
+
+    CountListener<T> listener;
+    DataWriter* writer = (publisher && writer_topic) ? publisher->create_datawriter(writer_topic, writer_qos) : nullptr;
+    DataReader* reader = (subscriber && filtered) ? subscriber->create_datareader(filtered, reader_qos, &listener) : nullptr;
+    bool ok = writer && reader && wait_for_match(writer, reader);
+
+    result.filter_case = c;
+    result.writer_side = writer_side;
+    if (ok) {
+        CounterSnapshot writer_before(*writer_factory.counters(type_name));
+        CounterSnapshot reader_before(*reader_factory.counters(type_name));
+
+        // Same seed in both modes: both publish the same samples
+        std::mt19937 gen(42);
+        T sample;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < samples; ++i) {
+            FilterBenchTraits<T>::randomize(sample, gen);
+            sample.timestamp(i);
+            result.offered_bytes += type->getSerializedSizeProvider(&sample)();
+            // KEEP_ALL blocks while the reader is behind; retry until it catches up
+            while (!writer->write(&sample)) {}
+            result.published++;
+        }
+        writer->wait_for_acknowledgments(eprosima::fastrtps::Duration_t(10, 0));
+
+        // Drain: wait until the reader stops making progress
+        uint64_t last = listener.count;
+        for (int idle = 0; idle < 5; ) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            uint64_t current = listener.count;
+            idle = (current == last) ? idle + 1 : 0;
+            last = current;
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        CounterSnapshot writer_after(*writer_factory.counters(type_name));
+        CounterSnapshot reader_after(*reader_factory.counters(type_name));
+        result.delivered = listener.count;
+        result.reader_evaluated = reader_after.evaluated - reader_before.evaluated;
+        if (writer_side) {
+            result.sent_samples = writer_after.passed - writer_before.passed;
+            result.sent_bytes = writer_after.passed_bytes - writer_before.passed_bytes;
+        } else {
+            result.sent_samples = result.reader_evaluated;
+            result.sent_bytes = reader_after.evaluated_bytes - reader_before.evaluated_bytes;
+        }
+    }
+
+    if (reader) subscriber->delete_datareader(reader);
+    if (writer) publisher->delete_datawriter(writer);
+    if (subscriber) reader_participant->delete_subscriber(subscriber);
+    if (publisher) writer_participant->delete_publisher(publisher);
+    if (filtered) reader_participant->delete_contentfilteredtopic(filtered);
+    if (reader_topic) reader_participant->delete_topic(reader_topic);
+    if (writer_topic) writer_participant->delete_topic(writer_topic);
+    writer_participant->unregister_type(type_name);
+    reader_participant->unregister_type(type_name);
+    return ok;
+}
+
+static bool run_case(DomainParticipant* writer_participant, VehicleFilterFactory& writer_factory,
+                     DomainParticipant* reader_participant, VehicleFilterFactory& reader_factory,
+                     const FilterCase& c, bool writer_side, uint32_t samples, FilterResult& result) {
+    if (c.topic == "powertrain") {
+        return run_filter_case<PowertrainData>(writer_participant, writer_factory, reader_participant,
+                                               reader_factory, c, writer_side, samples, result);
+    }
+    if (c.topic == "chassis") {
+        return run_filter_case<ChassisData>(writer_participant, writer_factory, reader_participant,
+                                            reader_factory, c, writer_side, samples, result);
+    }
+    if (c.topic == "battery") {
+        return run_filter_case<BatteryData>(writer_participant, writer_factory, reader_participant,
+                                            reader_factory, c, writer_side, samples, result);
+    }
+    if (c.topic == "adas") {
+        return run_filter_case<ADASData>(writer_participant, writer_factory, reader_participant,
+                                         reader_factory, c, writer_side, samples, result);
+    }
+    std::cerr << "Unknown topic: " << c.topic << std::endl;
+    return false;
+}
+
+static void write_csv(std::ostream& out, const std::vector<FilterResult>& results) {
+    out << "topic,expression,filtering,published,delivered,sent_samples,sent_bytes,offered_bytes,"
+        << "saved_pct,reader_evaluated,seconds\n";
+    for (const auto& r : results) {
+        double saved = r.offered_bytes > 0 ? 100.0 * (1.0 - static_cast<double>(r.sent_bytes) / r.offered_bytes) : 0.0;
+        out << r.filter_case.topic << ",\"" << r.filter_case.expression << "\","
+            << (r.writer_side ? "writer" : "reader") << ',' << r.published << ',' << r.delivered << ','
+            << r.sent_samples << ',' << r.sent_bytes << ',' << r.offered_bytes << ','
+            << saved << ',' << r.reader_evaluated << ',' << r.seconds << '\n';
+    }
+}
+
+static void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --samples <n>                 samples published per case and mode (default: 10000)\n"
+              << "  --filter <topic>:<expression> filter case, repeatable; topic is powertrain,\n"
+              << "                                chassis, battery or adas (default: powertrain\n"
+              << "                                engine_temperature > 90, chassis abs_active = TRUE,\n"
+              << "                                adas forward_collision_warning = TRUE)\n"
+              << "  --output <file>               CSV results (default: stdout)\n"
+              << transport_usage()
+              << "                                (default transport: udp)\n";
+}
+
+static bool parse_options(int argc, char** argv, FilterBenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--samples" && i + 1 < argc) {
+            options.samples = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--filter" && i + 1 < argc) {
+            std::string value = argv[++i];
+            size_t sep = value.find(':');
+            if (sep == std::string::npos) return false;
+            options.cases.push_back({value.substr(0, sep), value.substr(sep + 1)});
+        } else if (arg == "--output" && i + 1 < argc) {
+            options.output = argv[++i];
+        } else if (!parse_transport_arg(argc, argv, i, options.transport)) {
+            return false;
+        }
+    }
+
+    if (options.cases.empty()) {
+        options.cases = {{"powertrain", "engine_temperature > 90"},
+                         {"chassis", "abs_active = TRUE"},
+                         {"adas", "forward_collision_warning = TRUE"}};
+    }
+    return options.samples > 0;
+}
+
+int main(int argc, char** argv) {
+    FilterBenchOptions options;
+    if (!parse_options(argc, argv, options)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    // Both participants live in this process; disable intraprocess delivery
+    // so samples actually go through the selected transport.
+    eprosima::fastrtps::LibrarySettingsAttributes library_settings;
+    library_settings.intraprocess_delivery = eprosima::fastrtps::INTRAPROCESS_OFF;
+    eprosima::fastrtps::xmlparser::XMLProfileManager::library_settings(library_settings);
+
+    DomainParticipantQos writer_qos;
+    writer_qos.name("FilterBench_Writer");
+    apply_transport(writer_qos, options.transport);
+    DomainParticipantQos reader_qos;
+    reader_qos.name("FilterBench_Reader");
+    apply_transport(reader_qos, options.transport);
+
+    // The factories must outlive the participants
+    VehicleFilterFactory writer_factory;
+    VehicleFilterFactory reader_factory;
+    DomainParticipant* writer_participant = DomainParticipantFactory::get_instance()->create_participant(0, writer_qos);
+    DomainParticipant* reader_participant = DomainParticipantFactory::get_instance()->create_participant(0, reader_qos);
+    if (writer_participant == nullptr || reader_participant == nullptr) {
+        std::cerr << "Failed to create participants" << std::endl;
+        return 1;
+    }
+    writer_participant->register_content_filter_factory(kVehicleFilterClass, &writer_factory);
+    reader_participant->register_content_filter_factory(kVehicleFilterClass, &reader_factory);
+
+    std::vector<FilterResult> results;
+    for (const auto& c : options.cases) {
+        for (bool writer_side : {true, false}) {
+            std::cerr << "[" << c.topic << " \"" << c.expression << "\" "
+                      << (writer_side ? "writer" : "reader") << "-side]" << std::endl;
+            FilterResult result;
+            if (!run_case(writer_participant, writer_factory, reader_participant, reader_factory,
+                          c, writer_side, options.samples, result)) {
+                std::cerr << "  endpoints did not match or the filter is invalid" << std::endl;
+                continue;
+            }
+            results.push_back(result);
+        }
+    }
+
+    DomainParticipantFactory::get_instance()->delete_participant(writer_participant);
+    DomainParticipantFactory::get_instance()->delete_participant(reader_participant);
+
+    if (options.output.empty()) {
+        write_csv(std::cout, results);
+    } else {
+        std::ofstream out(options.output);
+        write_csv(out, results);
+        std::cerr << "Results written to " << options.output << std::endl;
+    }
+    return 0;
+}
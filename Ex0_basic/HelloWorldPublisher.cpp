@@ -1,5 +1,6 @@
 #include "HelloWorld.h"
 #include "HelloWorldPubSubTypes.h"
+#include "PeriodicScheduler.hpp"
 
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
 #include <fastdds/dds/domain/DomainParticipant.hpp>
@@ -63,9 +64,10 @@ public:
     }
 
     void run() {
+        PeriodicTimer timer(std::chrono::seconds(1));
         while (true) {
             publish();
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+            timer.wait();
         }
     }
 };
@@ -1,5 +1,6 @@
 #include "HelloWorld.h"
 #include "HelloWorldPubSubTypes.h"
+#include "BatchTake.hpp"
 
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
 #include <fastdds/dds/domain/DomainParticipant.hpp>
@@ -25,23 +26,21 @@ private:
 
     class SubListener : public DataReaderListener {
     public:
-        SubListener() = default;
+        int32_t max_batch = kDefaultMaxBatch;
 
         void on_data_available(DataReader* reader) override {
-            HelloWorld sample;
-            SampleInfo info;
-            if (reader->take_next_sample(&sample, &info) == ReturnCode_t::RETCODE_OK) {
-                if (info.valid_data) {
-                    std::cout << "Message received: " << sample.message() << std::endl;
-                    std::cout << "Index: " << sample.index() << std::endl;
-                }
-            }
+            take_batches<HelloWorld>(reader, max_batch, [](const HelloWorld& sample, const SampleInfo&) {
+                std::cout << "Message received: " << sample.message() << "\n";
+                std::cout << "Index: " << sample.index() << std::endl;
+            });
         }
     } listener_;
 
 public:
-    HelloWorldSubscriber() : participant_(nullptr), subscriber_(nullptr), topic_(nullptr), reader_(nullptr),
-                            type_(new HelloWorldPubSubType()) {
+    explicit HelloWorldSubscriber(int32_t max_batch = kDefaultMaxBatch)
+        : participant_(nullptr), subscriber_(nullptr), topic_(nullptr), reader_(nullptr),
+          type_(new HelloWorldPubSubType()) {
+        listener_.max_batch = max_batch;
     }
 
     bool init() {
@@ -76,8 +75,8 @@ public:
     }
 };
 
-int main() {
-    HelloWorldSubscriber* subscriber = new HelloWorldSubscriber();
+int main(int argc, char** argv) {
+    HelloWorldSubscriber* subscriber = new HelloWorldSubscriber(parse_max_batch(argc, argv));
     if (subscriber->init()) {
         subscriber->run();
     }
@@ -1,5 +1,6 @@
 #include "DomainTest.h"
 #include "DomainTestPubSubTypes.h"
+#include "PeriodicScheduler.hpp"
 
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
 #include <fastdds/dds/domain/DomainParticipant.hpp>
@@ -71,9 +72,10 @@ public:
     }
 
     void run() {
+        PeriodicTimer timer(std::chrono::seconds(1));
         while (true) {
             publish();
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+            timer.wait();
         }
     }
 };
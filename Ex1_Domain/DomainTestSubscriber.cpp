@@ -1,5 +1,6 @@
 #include "DomainTest.h"
 #include "DomainTestPubSubTypes.h"
+#include "BatchTake.hpp"
 
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
 #include <fastdds/dds/domain/DomainParticipant.hpp>
@@ -27,28 +28,25 @@ private:
 
     class SubListener : public DataReaderListener {
     public:
-        SubListener() = default;
+        int32_t max_batch = kDefaultMaxBatch;
 
         void on_data_available(DataReader* reader) override {
-            DomainTest sample;
-            SampleInfo info;
-            if (reader->take_next_sample(&sample, &info) == ReturnCode_t::RETCODE_OK) {
-                if (info.valid_data) {
-                    std::cout << "Message received: " << sample.message() << std::endl;
-                    std::cout << "Index: " << sample.index() << std::endl;
-                }
-            }
+            take_batches<DomainTest>(reader, max_batch, [](const DomainTest& sample, const SampleInfo&) {
+                std::cout << "Message received: " << sample.message() << "\n";
+                std::cout << "Index: " << sample.index() << std::endl;
+            });
         }
     } listener_;
 
 public:
-    DomainTestSubscriber(uint32_t domain_id) 
+    DomainTestSubscriber(uint32_t domain_id, int32_t max_batch = kDefaultMaxBatch) 
         : participant_(nullptr)
         , subscriber_(nullptr)
         , topic_(nullptr)
         , reader_(nullptr)
         , type_(new DomainTestPubSubType())
         , domain_id_(domain_id) {
+        listener_.max_batch = max_batch;
     }
 
     bool init() {
@@ -85,8 +83,8 @@ public:
 };
 
 int main(int argc, char** argv) {
-    if (argc != 2) {
-        std::cout << "Usage: " << argv[0] << " <domain_id>" << std::endl;
+    if (argc != 2 && argc != 4) {
+        std::cout << "Usage: " << argv[0] << " <domain_id> [--max-batch <n>]" << std::endl;
         std::cout << "domain_id must be a single digit (0-9)" << std::endl;
         return 1;
     }
@@ -98,7 +96,7 @@ int main(int argc, char** argv) {
         return 1;
     }
 
-    DomainTestSubscriber* subscriber = new DomainTestSubscriber(domain_id);
+    DomainTestSubscriber* subscriber = new DomainTestSubscriber(domain_id, parse_max_batch(argc, argv));
     if (subscriber->init()) {
         subscriber->run();
     }
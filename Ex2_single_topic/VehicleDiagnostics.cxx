@@ -102,7 +102,7 @@ bool ErrorCode::operator !=(
  * @param _code New value to be copied in member code
  */
 void ErrorCode::code(
-        const std::string& _code)
+        const eprosima::fastcdr::fixed_string<8>& _code)
 {
     m_code = _code;
 }
@@ -112,7 +112,7 @@ void ErrorCode::code(
  * @param _code New value to be moved in member code
  */
 void ErrorCode::code(
-        std::string&& _code)
+        eprosima::fastcdr::fixed_string<8>&& _code)
 {
     m_code = std::move(_code);
 }
@@ -121,7 +121,7 @@ void ErrorCode::code(
  * @brief This function returns a constant reference to member code
  * @return Constant reference to member code
  */
-const std::string& ErrorCode::code() const
+const eprosima::fastcdr::fixed_string<8>& ErrorCode::code() const
 {
     return m_code;
 }
@@ -130,7 +130,7 @@ const std::string& ErrorCode::code() const
  * @brief This function returns a reference to member code
  * @return Reference to member code
  */
-std::string& ErrorCode::code()
+eprosima::fastcdr::fixed_string<8>& ErrorCode::code()
 {
     return m_code;
 }
@@ -141,7 +141,7 @@ std::string& ErrorCode::code()
  * @param _description New value to be copied in member description
  */
 void ErrorCode::description(
-        const std::string& _description)
+        const eprosima::fastcdr::fixed_string<64>& _description)
 {
     m_description = _description;
 }
@@ -151,7 +151,7 @@ void ErrorCode::description(
  * @param _description New value to be moved in member description
  */
 void ErrorCode::description(
-        std::string&& _description)
+        eprosima::fastcdr::fixed_string<64>&& _description)
 {
     m_description = std::move(_description);
 }
@@ -160,7 +160,7 @@ void ErrorCode::description(
  * @brief This function returns a constant reference to member description
  * @return Constant reference to member description
  */
-const std::string& ErrorCode::description() const
+const eprosima::fastcdr::fixed_string<64>& ErrorCode::description() const
 {
     return m_description;
 }
@@ -169,7 +169,7 @@ const std::string& ErrorCode::description() const
  * @brief This function returns a reference to member description
  * @return Reference to member description
  */
-std::string& ErrorCode::description()
+eprosima::fastcdr::fixed_string<64>& ErrorCode::description()
 {
     return m_description;
 }
@@ -325,7 +325,7 @@ uint64_t& VehicleDiagnostics::timestamp()
  * @param _vehicle_id New value to be copied in member vehicle_id
  */
 void VehicleDiagnostics::vehicle_id(
-        const std::string& _vehicle_id)
+        const eprosima::fastcdr::fixed_string<17>& _vehicle_id)
 {
     m_vehicle_id = _vehicle_id;
 }
@@ -335,7 +335,7 @@ void VehicleDiagnostics::vehicle_id(
  * @param _vehicle_id New value to be moved in member vehicle_id
  */
 void VehicleDiagnostics::vehicle_id(
-        std::string&& _vehicle_id)
+        eprosima::fastcdr::fixed_string<17>&& _vehicle_id)
 {
     m_vehicle_id = std::move(_vehicle_id);
 }
@@ -344,7 +344,7 @@ void VehicleDiagnostics::vehicle_id(
  * @brief This function returns a constant reference to member vehicle_id
  * @return Constant reference to member vehicle_id
  */
-const std::string& VehicleDiagnostics::vehicle_id() const
+const eprosima::fastcdr::fixed_string<17>& VehicleDiagnostics::vehicle_id() const
 {
     return m_vehicle_id;
 }
@@ -353,7 +353,7 @@ const std::string& VehicleDiagnostics::vehicle_id() const
  * @brief This function returns a reference to member vehicle_id
  * @return Reference to member vehicle_id
  */
-std::string& VehicleDiagnostics::vehicle_id()
+eprosima::fastcdr::fixed_string<17>& VehicleDiagnostics::vehicle_id()
 {
     return m_vehicle_id;
 }
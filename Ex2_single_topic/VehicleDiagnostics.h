@@ -135,26 +135,26 @@ public:
      * @param _code New value to be copied in member code
      */
     eProsima_user_DllExport void code(
-            const std::string& _code);
+            const eprosima::fastcdr::fixed_string<8>& _code);
 
     /*!
      * @brief This function moves the value in member code
      * @param _code New value to be moved in member code
      */
     eProsima_user_DllExport void code(
-            std::string&& _code);
+            eprosima::fastcdr::fixed_string<8>&& _code);
 
     /*!
      * @brief This function returns a constant reference to member code
      * @return Constant reference to member code
      */
-    eProsima_user_DllExport const std::string& code() const;
+    eProsima_user_DllExport const eprosima::fastcdr::fixed_string<8>& code() const;
 
     /*!
      * @brief This function returns a reference to member code
      * @return Reference to member code
      */
-    eProsima_user_DllExport std::string& code();
+    eProsima_user_DllExport eprosima::fastcdr::fixed_string<8>& code();
 
 
     /*!
@@ -162,26 +162,26 @@ public:
      * @param _description New value to be copied in member description
      */
     eProsima_user_DllExport void description(
-            const std::string& _description);
+            const eprosima::fastcdr::fixed_string<64>& _description);
 
     /*!
      * @brief This function moves the value in member description
      * @param _description New value to be moved in member description
      */
     eProsima_user_DllExport void description(
-            std::string&& _description);
+            eprosima::fastcdr::fixed_string<64>&& _description);
 
     /*!
      * @brief This function returns a constant reference to member description
      * @return Constant reference to member description
      */
-    eProsima_user_DllExport const std::string& description() const;
+    eProsima_user_DllExport const eprosima::fastcdr::fixed_string<64>& description() const;
 
     /*!
      * @brief This function returns a reference to member description
      * @return Reference to member description
      */
-    eProsima_user_DllExport std::string& description();
+    eProsima_user_DllExport eprosima::fastcdr::fixed_string<64>& description();
 
 
     /*!
@@ -205,8 +205,8 @@ public:
 
 private:
 
-    std::string m_code;
-    std::string m_description;
+    eprosima::fastcdr::fixed_string<8> m_code;
+    eprosima::fastcdr::fixed_string<64> m_description;
     bool m_is_critical{false};
 
 };
@@ -299,26 +299,26 @@ public:
      * @param _vehicle_id New value to be copied in member vehicle_id
      */
     eProsima_user_DllExport void vehicle_id(
-            const std::string& _vehicle_id);
+            const eprosima::fastcdr::fixed_string<17>& _vehicle_id);
 
     /*!
      * @brief This function moves the value in member vehicle_id
      * @param _vehicle_id New value to be moved in member vehicle_id
      */
     eProsima_user_DllExport void vehicle_id(
-            std::string&& _vehicle_id);
+            eprosima::fastcdr::fixed_string<17>&& _vehicle_id);
 
     /*!
      * @brief This function returns a constant reference to member vehicle_id
      * @return Constant reference to member vehicle_id
      */
-    eProsima_user_DllExport const std::string& vehicle_id() const;
+    eProsima_user_DllExport const eprosima::fastcdr::fixed_string<17>& vehicle_id() const;
 
     /*!
      * @brief This function returns a reference to member vehicle_id
      * @return Reference to member vehicle_id
      */
-    eProsima_user_DllExport std::string& vehicle_id();
+    eProsima_user_DllExport eprosima::fastcdr::fixed_string<17>& vehicle_id();
 
 
     /*!
@@ -450,7 +450,7 @@ public:
 private:
 
     uint64_t m_timestamp{0};
-    std::string m_vehicle_id;
+    eprosima::fastcdr::fixed_string<17> m_vehicle_id;
     float m_engine_rpm{0.0};
     float m_vehicle_speed{0.0};
     float m_engine_temperature{0.0};
@@ -24,10 +24,10 @@
 
 #include "VehicleDiagnostics.h"
 
-constexpr uint32_t VehicleDiagnostics_max_cdr_typesize {53101UL};
-constexpr uint32_t VehicleDiagnostics_max_key_cdr_typesize {0UL};
+constexpr uint32_t VehicleDiagnostics_max_cdr_typesize {1538UL};
+constexpr uint32_t VehicleDiagnostics_max_key_cdr_typesize {22UL};
 
-constexpr uint32_t ErrorCode_max_cdr_typesize {525UL};
+constexpr uint32_t ErrorCode_max_cdr_typesize {90UL};
 constexpr uint32_t ErrorCode_max_key_cdr_typesize {0UL};
 
 
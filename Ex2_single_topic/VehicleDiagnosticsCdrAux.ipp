@@ -259,8 +259,11 @@ void serialize_key(
         eprosima::fastcdr::Cdr& scdr,
         const VehicleDiagnostics& data)
 {
+
     static_cast<void>(scdr);
     static_cast<void>(data);
+                        scdr << data.vehicle_id();
+
 }
 
 
@@ -1,5 +1,7 @@
 #include "VehicleDiagnostics.h"
 #include "VehicleDiagnosticsPubSubTypes.h"
+#include "PeriodicScheduler.hpp"
+#include "SnapshotBuffer.hpp"
 
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
 #include <fastdds/dds/domain/DomainParticipant.hpp>
@@ -14,13 +16,93 @@
 #include <iostream>
 #include <string>
 #include <atomic>
-#include <mutex>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
 
 using namespace eprosima::fastdds::dds;
 
+// Bound of error_codes (sequence<ErrorCode, 16> in VehicleDiagnostics.idl).
+// A longer sequence does not fit the preallocated payload and write() fails.
+const size_t kMaxErrorCodes = 16;
+
+// Active diagnostic trouble codes, kept in VehicleDiagnostics::error_codes.
+// Like an ECU's fault memory, a code is stored once when its fault is
+// detected and removed when the fault has cleared, so the sequence holds
+// what is wrong right now: it never exceeds kMaxErrorCodes, and its size
+// does not depend on how long the vehicle has been running. set() and
+// clear() scan at most kMaxErrorCodes entries.
+class ActiveDtcSet {
+private:
+    uint64_t overflows_;  // codes not stored because the set was full
+    uint64_t clears_;     // codes removed after their fault cleared
+
+    static std::vector<ErrorCode>::iterator find(std::vector<ErrorCode>& codes, const char* code) {
+        auto it = codes.begin();
+        while (it != codes.end() && std::strcmp(it->code().c_str(), code) != 0) ++it;
+        return it;
+    }
+
+    // Sets the code while 'fault' holds and clears it once 'recovered' holds;
+    // in between (hysteresis band) the code keeps its state
+    void track(std::vector<ErrorCode>& codes, const char* code, const char* description,
+               bool critical, bool fault, bool recovered) {
+        if (fault) {
+            set(codes, code, description, critical);
+        } else if (recovered) {
+            clear(codes, code);
+        }
+    }
+
+public:
+    ActiveDtcSet() : overflows_(0), clears_(0) {}
+
+    // Returns true if the code was added (false: already active, or the set is full)
+    bool set(std::vector<ErrorCode>& codes, const char* code, const char* description, bool critical) {
+        if (find(codes, code) != codes.end()) return false;
+        if (codes.size() >= kMaxErrorCodes) {
+            overflows_++;
+            return false;
+        }
+        ErrorCode error;
+        error.code(code);
+        error.description(description);
+        error.is_critical(critical);
+        codes.push_back(error);
+        return true;
+    }
+
+    // Returns true if the code was active
+    bool clear(std::vector<ErrorCode>& codes, const char* code) {
+        auto it = find(codes, code);
+        if (it == codes.end()) return false;
+        codes.erase(it);
+        clears_++;
+        return true;
+    }
+
+    // Sets and clears the codes of the monitored faults for the current values
+    void evaluate(VehicleDiagnostics& data) {
+        std::vector<ErrorCode>& codes = data.error_codes();
+        track(codes, "P0217", "Engine Overheating Warning", true,
+              data.engine_temperature() > 90.0f, data.engine_temperature() < 85.0f);
+        track(codes, "P0219", "Engine Overspeed Condition", false,
+              data.engine_rpm() > 2900.0f, data.engine_rpm() < 2700.0f);
+        track(codes, "P0562", "System Voltage Low", false,
+              data.battery_voltage() < 11.5f, data.battery_voltage() > 12.0f);
+    }
+
+    uint64_t overflows() const { return overflows_; }
+    uint64_t clears() const { return clears_; }
+};
+
 class VehicleDiagnosticsPublisher {
 private:
-    VehicleDiagnostics diagnostics_;
+    // set_value() and the random generator publish snapshots here; the
+    // publishing thread writes the newest one without blocking them
+    SnapshotBuffer<VehicleDiagnostics> diagnostics_;
     DomainParticipant* participant_;
     Publisher* publisher_;
     Topic* topic_;
@@ -35,9 +117,9 @@ private:
     std::uniform_real_distribution<> fuel_dist_;
     std::uniform_real_distribution<> voltage_dist_;
 
-    std::mutex mtx_;
     std::atomic<bool> is_running_;
-    bool use_random_values_;
+    std::atomic<bool> use_random_values_;
+    ActiveDtcSet dtcs_;  // updated under the SnapshotBuffer's producer lock
 
 public:
     VehicleDiagnosticsPublisher() 
@@ -78,38 +160,35 @@ public:
     }
 
     void set_value(const std::string& param, float value) {
-        std::lock_guard<std::mutex> lock(mtx_);
-        if (param == "rpm") diagnostics_.engine_rpm(value);
-        else if (param == "speed") diagnostics_.vehicle_speed(value);
-        else if (param == "temp") diagnostics_.engine_temperature(value);
-        else if (param == "fuel") diagnostics_.fuel_level(value);
-        else if (param == "voltage") diagnostics_.battery_voltage(value);
+        diagnostics_.update([&](VehicleDiagnostics& data) {
+            if (param == "rpm") data.engine_rpm(value);
+            else if (param == "speed") data.vehicle_speed(value);
+            else if (param == "temp") data.engine_temperature(value);
+            else if (param == "fuel") data.fuel_level(value);
+            else if (param == "voltage") data.battery_voltage(value);
+        });
     }
 
     void update_random_values() {
-        std::lock_guard<std::mutex> lock(mtx_);
-        diagnostics_.engine_rpm(rpm_dist_(gen_));
-        diagnostics_.vehicle_speed(speed_dist_(gen_));
-        diagnostics_.engine_temperature(temp_dist_(gen_));
-        diagnostics_.fuel_level(fuel_dist_(gen_));
-        diagnostics_.battery_voltage(voltage_dist_(gen_));
+        diagnostics_.update([this](VehicleDiagnostics& data) {
+            data.engine_rpm(rpm_dist_(gen_));
+            data.vehicle_speed(speed_dist_(gen_));
+            data.engine_temperature(temp_dist_(gen_));
+            data.fuel_level(fuel_dist_(gen_));
+            data.battery_voltage(voltage_dist_(gen_));
+        });
     }
 
     bool publish() {
-        std::lock_guard<std::mutex> lock(mtx_);
-        
-        diagnostics_.timestamp(std::chrono::system_clock::now().time_since_epoch().count());
-        diagnostics_.vehicle_id("VIN123456789");
-
-        if (diagnostics_.engine_temperature() > 90.0) {
-            ErrorCode error;
-            error.code("P0217");
-            error.description("Engine Overheating Warning");
-            error.is_critical(true);
-            diagnostics_.error_codes().push_back(error);
-        }
+        // The active codes are part of the state, so they are updated on the producer side
+        diagnostics_.update([this](VehicleDiagnostics& data) {
+            data.vehicle_id("VIN123456789");
+            dtcs_.evaluate(data);
+        });
 
-        writer_->write(&diagnostics_);
+        VehicleDiagnostics& sample = diagnostics_.acquire();
+        sample.timestamp(std::chrono::system_clock::now().time_since_epoch().count());
+        writer_->write(&sample);
         return true;
     }
 
@@ -117,6 +196,87 @@ public:
         is_running_ = false;
     }
 
+    // Runs the publishing cycle offline (random values + DTC update, no DDS)
+    // for the given simulated time at the 4 s publish period and checks that
+    // the payload stays flat:
+    //  - codes clear again: some were removed, and the set went back to empty
+    //    (codes that only pile up would keep the payload at its peak)
+    //  - no sample is larger than one with every monitored code active
+    //  - the last simulated hour is no larger than the first one
+    // The generator is seeded with a fixed value so the run is repeatable;
+    // with this seed the first hour already reaches the all-faults sample.
+    // Returns false if any check fails.
+    bool simulate(double hours) {
+        const double kPeriodSeconds = 4.0;
+        const uint32_t kSimulationSeed = 20240101;
+        const uint64_t cycles = static_cast<uint64_t>(hours * 3600.0 / kPeriodSeconds);
+        const uint64_t cycles_per_hour = static_cast<uint64_t>(3600.0 / kPeriodSeconds);
+        gen_.seed(kSimulationSeed);
+
+        VehicleDiagnostics data;
+        data.vehicle_id("VIN123456789");
+        auto serialized_size = [this, &data]() {
+            return type_.get_serialized_size_provider(&data)();
+        };
+
+        // Upper bound: all monitored faults present. The size depends only on
+        // which codes are active, each ErrorCode ending 4-byte aligned.
+        data.engine_temperature(100.0f);
+        data.engine_rpm(3000.0f);
+        data.battery_voltage(11.0f);
+        ActiveDtcSet all_faults;
+        all_faults.evaluate(data);
+        const uint32_t bound = serialized_size();
+        const size_t monitored = data.error_codes().size();
+        data.error_codes().clear();
+
+        ActiveDtcSet dtcs;
+        uint32_t min_size = UINT32_MAX;
+        uint32_t max_size = 0;
+        uint32_t first_hour_max = 0;
+        uint32_t last_hour_max = 0;
+        size_t max_active = 0;
+        uint64_t sets = 0;
+        uint64_t emptied = 0;  // cycles that cleared the last active code
+        for (uint64_t cycle = 0; cycle < cycles; ++cycle) {
+            data.engine_rpm(rpm_dist_(gen_));
+            data.vehicle_speed(speed_dist_(gen_));
+            data.engine_temperature(temp_dist_(gen_));
+            data.fuel_level(fuel_dist_(gen_));
+            data.battery_voltage(voltage_dist_(gen_));
+            size_t before = data.error_codes().size();
+            dtcs.evaluate(data);
+            if (data.error_codes().size() > before) sets++;
+            if (before > 0 && data.error_codes().empty()) emptied++;
+
+            uint32_t size = serialized_size();
+            min_size = std::min(min_size, size);
+            max_size = std::max(max_size, size);
+            if (cycle < cycles_per_hour) first_hour_max = std::max(first_hour_max, size);
+            if (cycle + cycles_per_hour >= cycles) last_hour_max = std::max(last_hour_max, size);
+            max_active = std::max(max_active, data.error_codes().size());
+        }
+
+        bool codes_clear = dtcs.clears() > 0 && emptied > 0;
+        bool size_bounded = max_size <= bound && max_active <= monitored && dtcs.overflows() == 0;
+        bool flat = last_hour_max <= first_hour_max;
+        std::cout << "Simulated " << hours << " h: " << cycles << " publish cycles\n"
+                  << "Serialized size: min " << min_size << ", max " << max_size
+                  << " bytes (first hour max " << first_hour_max
+                  << ", last hour max " << last_hour_max << ")\n"
+                  << "Bound with all " << monitored << " monitored codes active: " << bound << " bytes\n"
+                  << "Active codes: max " << max_active << ", " << sets << " cycles set a new code, "
+                  << dtcs.clears() << " codes cleared, " << emptied << " times back to none, "
+                  << dtcs.overflows() << " overflows\n";
+        if (!codes_clear) std::cout << "FAIL: active codes never clear\n";
+        if (!size_bounded) std::cout << "FAIL: sample larger than with every monitored code active\n";
+        if (!flat) std::cout << "FAIL: payload grew from the first to the last hour\n";
+        bool passed = codes_clear && size_bounded && flat;
+        if (passed) std::cout << "PASS: payload stays flat\n";
+        std::cout.flush();
+        return passed;
+    }
+
     void disable_random() {
         use_random_values_ = false;
     }
@@ -127,12 +287,14 @@ public:
         
         // 발행 스레드 시작
         std::thread publish_thread([this]() {
+            PeriodicTimer timer(std::chrono::milliseconds(4000));
             while (is_running_) {
                 if (use_random_values_) {
                     update_random_values();
                 }
                 publish();
-                std::this_thread::sleep_for(std::chrono::milliseconds(4000));
+                // Wake up at least every 100 ms to notice quit
+                while (is_running_ && !timer.wait(PeriodicTimer::Clock::now() + std::chrono::milliseconds(100))) {}
             }
         });
 
@@ -178,7 +340,18 @@ public:
     }
 };
 
-int main() {
+int main(int argc, char** argv) {
+    // --simulate [hours]: offline run of the publish cycle (default 24 h) that
+    // checks the serialized size of the sample stays bounded; exit code 1 if not
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--simulate") {
+            double hours = 24.0;
+            if (i + 1 < argc && std::atof(argv[i + 1]) > 0.0) hours = std::atof(argv[i + 1]);
+            VehicleDiagnosticsPublisher simulator;
+            return simulator.simulate(hours) ? 0 : 1;
+        }
+    }
+
     VehicleDiagnosticsPublisher* publisher = new VehicleDiagnosticsPublisher();
     if (publisher->init()) {
         publisher->run();
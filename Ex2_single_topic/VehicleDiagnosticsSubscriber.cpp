@@ -1,5 +1,9 @@
 #include "VehicleDiagnostics.h"
 #include "VehicleDiagnosticsPubSubTypes.h"
+#include "RenderQueue.hpp"
+#include "TerminalFrame.hpp"
+#include "BatchTake.hpp"
+#include "AllocationCounter.hpp"
 
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
 #include <fastdds/dds/domain/DomainParticipant.hpp>
@@ -25,77 +29,112 @@ private:
     DataReader* reader_;
     TypeSupport type_;
 
+    // Runs on the Fast DDS receive thread: only queues the samples,
+    // formatting and printing happen on the render thread
     class SubListener : public DataReaderListener {
     public:
-        SubListener() = default;
+        RenderQueue<VehicleDiagnostics> queue;
+        int32_t max_batch = kDefaultMaxBatch;
+        AllocationStats allocations;  // heap allocations on this receive path
 
         void on_data_available(DataReader* reader) override {
-            VehicleDiagnostics sample;
-            SampleInfo info;
-            
-            while (reader->take_next_sample(&sample, &info) == ReturnCode_t::RETCODE_OK) {
-                if (info.valid_data) {
-                    // Convert timestamp to human readable format
-                    auto timestamp = std::chrono::system_clock::time_point(
-                        std::chrono::nanoseconds(sample.timestamp()));
-                    auto time_t = std::chrono::system_clock::to_time_t(timestamp);
-                    
-                    std::cout << "\033[2J\033[H";  // Clear screen and move cursor to top
-                    std::cout << "=== Vehicle Diagnostics Report ===\n";
-                    std::cout << "Time: " << std::ctime(&time_t);
-                    std::cout << "Vehicle ID: " << sample.vehicle_id() << "\n\n";
-                    
-                    // Display gauge for RPM
-                    std::cout << "Engine RPM: " << std::fixed << std::setprecision(1) 
-                              << sample.engine_rpm() << " RPM";
-                    if (sample.engine_rpm() > 2500) {
-                        std::cout << " \033[31m[HIGH]\033[0m";
-                    }
-                    std::cout << "\n";
-                    
-                    // Display other metrics
-                    std::cout << "Vehicle Speed: " << sample.vehicle_speed() << " km/h\n";
-                    std::cout << "Engine Temp: " << sample.engine_temperature() << " °C";
-                    if (sample.engine_temperature() > 90) {
-                        std::cout << " \033[31m[WARNING]\033[0m";
-                    }
-                    std::cout << "\n";
-                    
-                    std::cout << "Fuel Level: " << sample.fuel_level() << "%";
-                    if (sample.fuel_level() < 20) {
-                        std::cout << " \033[33m[LOW]\033[0m";
-                    }
-                    std::cout << "\n";
-                    
-                    std::cout << "Battery: " << sample.battery_voltage() << "V";
-                    if (sample.battery_voltage() < 11.5) {
-                        std::cout << " \033[31m[LOW]\033[0m";
-                    }
-                    std::cout << "\n\n";
-
-                    // Display error codes if any
-                    if (!sample.error_codes().empty()) {
-                        std::cout << "=== Active Error Codes ===\n";
-                        for (const auto& error : sample.error_codes()) {
-                            std::cout << error.code() << ": " << error.description();
-                            if (error.is_critical()) {
-                                std::cout << " \033[31m[CRITICAL]\033[0m";
-                            }
-                            std::cout << "\n";
-                        }
-                    }
+            uint64_t before = alloc_counter::thread_allocations();
+            size_t taken = take_batches<VehicleDiagnostics>(reader, max_batch,
+                [this](const VehicleDiagnostics& sample, const SampleInfo&) {
+                    // error_codes are copied into the cell's existing vector/string capacity
+                    queue.push(sample);
+                });
+            allocations.add(alloc_counter::thread_allocations() - before, taken);
+        }
+    } listener_;
+
+    TerminalFrame frame_;
+    VehicleDiagnostics latest_;
+    // Declared after everything render_frame() uses, so it is destroyed (and
+    // its thread joined after the final frame) first
+    RenderLoop render_loop_;
+
+    // Drains the queue and redraws the lines of the newest sample that changed,
+    // at most once per frame
+    void render_frame() {
+        bool updated = false;
+        while (listener_.queue.pop(latest_)) {
+            updated = true;
+        }
+        if (!updated) return;
+
+        const VehicleDiagnostics& sample = latest_;
+
+        // Convert timestamp to human readable format
+        auto timestamp = std::chrono::system_clock::time_point(
+            std::chrono::nanoseconds(sample.timestamp()));
+        auto time_t = std::chrono::system_clock::to_time_t(timestamp);
+        
+        std::ostream& out = frame_.begin();
+        out << "=== Vehicle Diagnostics Report ===\n";
+        out << "Time: " << std::ctime(&time_t);
+        out << "Vehicle ID: " << sample.vehicle_id().c_str() << "\n\n";
+        
+        // Display gauge for RPM
+        out << "Engine RPM: " << std::fixed << std::setprecision(1) 
+            << sample.engine_rpm() << " RPM";
+        if (sample.engine_rpm() > 2500) {
+            out << " \033[31m[HIGH]\033[0m";
+        }
+        out << "\n";
+        
+        // Display other metrics
+        out << "Vehicle Speed: " << sample.vehicle_speed() << " km/h\n";
+        out << "Engine Temp: " << sample.engine_temperature() << " °C";
+        if (sample.engine_temperature() > 90) {
+            out << " \033[31m[WARNING]\033[0m";
+        }
+        out << "\n";
+        
+        out << "Fuel Level: " << sample.fuel_level() << "%";
+        if (sample.fuel_level() < 20) {
+            out << " \033[33m[LOW]\033[0m";
+        }
+        out << "\n";
+        
+        out << "Battery: " << sample.battery_voltage() << "V";
+        if (sample.battery_voltage() < 11.5) {
+            out << " \033[31m[LOW]\033[0m";
+        }
+        out << "\n\n";
+
+        // Display error codes if any
+        if (!sample.error_codes().empty()) {
+            out << "=== Active Error Codes ===\n";
+            for (const auto& error : sample.error_codes()) {
+                out << error.code().c_str() << ": " << error.description().c_str();
+                if (error.is_critical()) {
+                    out << " \033[31m[CRITICAL]\033[0m";
                 }
+                out << "\n";
             }
         }
-    } listener_;
+
+        uint64_t allocs = 0;
+        uint64_t samples = 0;
+        listener_.allocations.take_window(allocs, samples);
+        out << "\nSamples: " << listener_.queue.pushed()
+            << " (dropped: " << listener_.queue.dropped() << ")\n";
+        if (alloc_counter::enabled()) {
+            out << "Receive allocations since last frame: " << allocs
+                << " for " << samples << " samples\n";
+        }
+        frame_.present();
+    }
 
 public:
-    VehicleDiagnosticsSubscriber()
+    explicit VehicleDiagnosticsSubscriber(int32_t max_batch = kDefaultMaxBatch)
         : participant_(nullptr)
         , subscriber_(nullptr)
         , topic_(nullptr)
         , reader_(nullptr)
         , type_(new VehicleDiagnosticsPubSubType()) {
+        listener_.max_batch = max_batch;
     }
 
     bool init() {
@@ -120,14 +159,15 @@ public:
     }
 
     void run() {
+        render_loop_.start([this]() { render_frame(); });
         while (true) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
     }
 };
 
-int main() {
-    VehicleDiagnosticsSubscriber* subscriber = new VehicleDiagnosticsSubscriber();
+int main(int argc, char** argv) {
+    VehicleDiagnosticsSubscriber* subscriber = new VehicleDiagnosticsSubscriber(parse_max_batch(argc, argv));
     if (subscriber->init()) {
         subscriber->run();
     }
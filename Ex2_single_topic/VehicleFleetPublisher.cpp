@@ -0,0 +1,333 @@
+#include "VehicleDiagnostics.h"
+#include "VehicleDiagnosticsPubSubTypes.h"
+#include "PeriodicScheduler.hpp"
+#include "LatencyHistogram.hpp"
+#include "ProcessMemory.hpp"
+
+#include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastdds/dds/domain/DomainParticipant.hpp>
+#include <fastdds/dds/topic/TypeSupport.hpp>
+#include <fastdds/dds/publisher/Publisher.hpp>
+#include <fastdds/dds/publisher/DataWriter.hpp>
+#include <fastdds/dds/publisher/qos/DataWriterQos.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastdds::dds;
+
+// Fleet simulator for the keyed VehicleDiagnostics topic: every vehicle is
+// one instance (vehicle_id is the @key), so the subscriber keeps the last
+// sample per vehicle instead of one stream for the whole fleet.
+
+struct FleetOptions {
+    size_t vehicles;          // instances, one per VIN
+    double rate;              // samples per second per vehicle
+    bool register_instances;  // write with the registered handle instead of hashing the key per write
+
+    FleetOptions()
+        : vehicles(1000)
+        , rate(1.0)
+        , register_instances(true) {}
+};
+
+static std::atomic<bool> g_running(true);
+
+class VehicleFleetPublisher {
+private:
+    struct Vehicle {
+        VehicleDiagnostics sample;
+        InstanceHandle_t handle;
+    };
+
+    FleetOptions options_;
+    DomainParticipant* participant_;
+    Publisher* publisher_;
+    Topic* topic_;
+    DataWriter* writer_;
+    TypeSupport type_;
+
+    std::vector<Vehicle> vehicles_;
+    std::mt19937 gen_;
+    std::uniform_real_distribution<float> step_;
+    LatencyHistogram write_ns_;
+
+    // 17 characters, like a real VIN: "KMHFLEET" + 9-digit vehicle number
+    static std::string vin(size_t index) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "KMHFLEET%09lu", static_cast<unsigned long>(index % 1000000000UL));
+        return buffer;
+    }
+
+    static float clamp(float value, float lo, float hi) {
+        return value < lo ? lo : (value > hi ? hi : value);
+    }
+
+    // Random walk, so consecutive samples of one vehicle stay plausible
+    void drive(VehicleDiagnostics& data) {
+        data.engine_rpm(clamp(data.engine_rpm() + 50.0f * step_(gen_), 800.0f, 3000.0f));
+        data.vehicle_speed(clamp(data.vehicle_speed() + 2.0f * step_(gen_), 0.0f, 120.0f));
+        data.engine_temperature(clamp(data.engine_temperature() + 0.5f * step_(gen_), 75.0f, 100.0f));
+        data.fuel_level(clamp(data.fuel_level() - 0.01f, 0.0f, 100.0f));
+        data.battery_voltage(clamp(data.battery_voltage() + 0.05f * step_(gen_), 11.0f, 14.4f));
+
+        if (data.engine_temperature() > 95.0f && data.error_codes().empty()) {
+            ErrorCode error;
+            error.code("P0217");
+            error.description("Engine Overheating Warning");
+            error.is_critical(true);
+            data.error_codes().push_back(error);
+        } else if (data.engine_temperature() < 90.0f && !data.error_codes().empty()) {
+            data.error_codes().clear();
+        }
+    }
+
+    bool write(Vehicle& vehicle) {
+        auto start = std::chrono::steady_clock::now();
+        bool ok = options_.register_instances
+                ? writer_->write(&vehicle.sample, vehicle.handle) == ReturnCode_t::RETCODE_OK
+                : writer_->write(&vehicle.sample);
+        write_ns_.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+        return ok;
+    }
+
+public:
+    explicit VehicleFleetPublisher(const FleetOptions& options)
+        : options_(options)
+        , participant_(nullptr)
+        , publisher_(nullptr)
+        , topic_(nullptr)
+        , writer_(nullptr)
+        , type_(new VehicleDiagnosticsPubSubType())
+        , gen_(std::random_device()())
+        , step_(-1.0f, 1.0f) {
+    }
+
+    ~VehicleFleetPublisher() {
+        if (participant_ != nullptr) {
+            if (publisher_ != nullptr && writer_ != nullptr)
+                publisher_->delete_datawriter(writer_);
+            if (publisher_ != nullptr)
+                participant_->delete_publisher(publisher_);
+            if (topic_ != nullptr)
+                participant_->delete_topic(topic_);
+            DomainParticipantFactory::get_instance()->delete_participant(participant_);
+        }
+    }
+
+    bool init() {
+        DomainParticipantQos participantQos;
+        participantQos.name("VehicleFleet_Publisher");
+
+        participant_ = DomainParticipantFactory::get_instance()->create_participant(0, participantQos);
+        if (participant_ == nullptr) return false;
+
+        type_.register_type(participant_);
+
+        publisher_ = participant_->create_publisher(PUBLISHER_QOS_DEFAULT);
+        if (publisher_ == nullptr) return false;
+
+        topic_ = participant_->create_topic("VehicleDiagnosticsTopic", "VehicleDiagnostics", TOPIC_QOS_DEFAULT);
+        if (topic_ == nullptr) return false;
+
+        // Last sample per vehicle. The default resource limits allow only 10
+        // instances, so they are sized for the fleet.
+        DataWriterQos qos = DATAWRITER_QOS_DEFAULT;
+        qos.history().kind = KEEP_LAST_HISTORY_QOS;
+        qos.history().depth = 1;
+        // main() keeps vehicles within int32_t
+        qos.resource_limits().max_instances = static_cast<int32_t>(options_.vehicles);
+        qos.resource_limits().max_samples_per_instance = 1;
+        qos.resource_limits().max_samples = static_cast<int32_t>(options_.vehicles);
+
+        writer_ = publisher_->create_datawriter(topic_, qos);
+        if (writer_ == nullptr) return false;
+
+        return true;
+    }
+
+    // Creates the vehicles, measures the key hash and registers the instances
+    void create_fleet() {
+        size_t rss_start = resident_bytes();
+
+        std::uniform_real_distribution<float> rpm(800.0f, 3000.0f);
+        std::uniform_real_distribution<float> speed(0.0f, 120.0f);
+        std::uniform_real_distribution<float> temp(75.0f, 95.0f);
+        std::uniform_real_distribution<float> fuel(10.0f, 100.0f);
+        std::uniform_real_distribution<float> voltage(11.5f, 14.4f);
+        vehicles_.resize(options_.vehicles);
+        for (size_t i = 0; i < vehicles_.size(); ++i) {
+            VehicleDiagnostics& data = vehicles_[i].sample;
+            data.vehicle_id(eprosima::fastcdr::fixed_string<17>(vin(i)));
+            data.engine_rpm(rpm(gen_));
+            data.vehicle_speed(speed(gen_));
+            data.engine_temperature(temp(gen_));
+            data.fuel_level(fuel(gen_));
+            data.battery_voltage(voltage(gen_));
+        }
+        size_t rss_samples = resident_bytes();
+
+        // The key (CDR string<17>, up to 22 bytes) is longer than a 16-byte
+        // handle, so every hash is an MD5 over the serialized key
+        LatencyHistogram key_ns;
+        InstanceHandle_t handle;
+        for (auto& vehicle : vehicles_) {
+            auto start = std::chrono::steady_clock::now();
+            type_.get_key(&vehicle.sample, &handle);
+            key_ns.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count()));
+        }
+
+        if (options_.register_instances) {
+            for (auto& vehicle : vehicles_) {
+                vehicle.handle = writer_->register_instance(&vehicle.sample);
+            }
+        }
+        size_t rss_registered = resident_bytes();
+
+        size_t n = vehicles_.empty() ? 1 : vehicles_.size();
+        std::cout << "Fleet: " << vehicles_.size() << " vehicles (instances), "
+                  << options_.rate << " samples/s each\n"
+                  << "Key hash (get_key): mean " << static_cast<uint64_t>(key_ns.mean())
+                  << " ns, p99 " << key_ns.percentile(99.0) << " ns\n"
+                  << "Memory per vehicle: ~" << (rss_samples - rss_start) / n << " bytes application state";
+        if (options_.register_instances) {
+            std::cout << ", ~" << (rss_registered - rss_samples) / n << " bytes writer instance";
+        }
+        std::cout << " (RSS deltas)\n"
+                  << (options_.register_instances ? "Writing with registered instance handles"
+                                                  : "Writing with HANDLE_NIL: the key is hashed on every write")
+                  << std::endl;
+    }
+
+    void run() {
+        typedef std::chrono::steady_clock Clock;
+
+        create_fleet();
+        std::cout << "Press Enter to stop." << std::endl;
+        std::thread input_thread([]() {
+            std::string line;
+            std::getline(std::cin, line);
+            g_running = false;
+        });
+
+        double rate = options_.rate * vehicles_.size();
+        size_t next_vehicle = 0;
+        uint64_t written = 0;
+        uint64_t failed = 0;
+        uint64_t reported = 0;
+
+        PeriodicTimer timer(std::chrono::milliseconds(1));
+        Clock::time_point start = Clock::now();
+        Clock::time_point next_report = start + std::chrono::seconds(1);
+        uint64_t attempted = 0;
+
+        while (g_running && !vehicles_.empty()) {
+            uint64_t target = static_cast<uint64_t>(std::chrono::duration<double>(Clock::now() - start).count() * rate);
+            // Blocked writes fall behind; catch up at most one second's worth
+            uint64_t max_backlog = static_cast<uint64_t>(rate) + 1;
+            if (target > attempted + max_backlog) attempted = target - max_backlog;
+
+            for (; attempted < target && g_running; ++attempted) {
+                Vehicle& vehicle = vehicles_[next_vehicle];
+                next_vehicle = (next_vehicle + 1) % vehicles_.size();
+
+                drive(vehicle.sample);
+                vehicle.sample.timestamp(std::chrono::system_clock::now().time_since_epoch().count());
+                if (write(vehicle)) {
+                    written++;
+                } else {
+                    failed++;
+                }
+            }
+
+            Clock::time_point now = Clock::now();
+            if (now >= next_report) {
+                std::cout << "Sent/s " << written - reported << " (failed writes " << failed << ")"
+                          << ", write() p50 " << write_ns_.percentile(50.0) / 1000.0 << " us"
+                          << ", p99 " << write_ns_.percentile(99.0) / 1000.0 << " us" << std::endl;
+                write_ns_.reset();
+                reported = written;
+                next_report += std::chrono::seconds(1);
+            }
+            timer.wait();
+        }
+
+        // Subscribers see the vehicles go NOT_ALIVE_NO_WRITERS
+        if (options_.register_instances) {
+            for (auto& vehicle : vehicles_) {
+                writer_->unregister_instance(&vehicle.sample, vehicle.handle);
+            }
+        }
+        if (input_thread.joinable()) {
+            input_thread.join();
+        }
+    }
+};
+
+// Parses a whole decimal number in [min, max]
+static bool parse_count(const char* text, long long min, long long max, long long& value) {
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtoll(text, &end, 10);
+    return end != text && *end == '\0' && errno == 0 && value >= min && value <= max;
+}
+
+static void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --vehicles <n> : Fleet size, one instance per VIN (default 1000)\n"
+              << "  --rate <hz>    : Samples per second per vehicle (default 1)\n"
+              << "  --no-register  : Write with HANDLE_NIL, so the writer hashes the key on every write\n";
+}
+
+int main(int argc, char** argv) {
+    try {
+        FleetOptions options;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--vehicles" && i + 1 < argc) {
+                // max_instances and max_samples of the writer are int32_t
+                long long value = 0;
+                if (!parse_count(argv[++i], 1, std::numeric_limits<int32_t>::max(), value)) {
+                    std::cout << "Invalid --vehicles: " << argv[i] << std::endl;
+                    return 1;
+                }
+                options.vehicles = static_cast<size_t>(value);
+            } else if (arg == "--rate" && i + 1 < argc) {
+                char* end = nullptr;
+                const char* text = argv[++i];
+                double value = std::strtod(text, &end);
+                if (end == text || *end != '\0' || !(value > 0.0)) {
+                    std::cout << "Invalid --rate: " << text << std::endl;
+                    return 1;
+                }
+                options.rate = value;
+            } else if (arg == "--no-register") {
+                options.register_instances = false;
+            } else {
+                print_usage(argv[0]);
+                return 1;
+            }
+        }
+
+        VehicleFleetPublisher publisher(options);
+        if (publisher.init()) {
+            publisher.run();
+        }
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
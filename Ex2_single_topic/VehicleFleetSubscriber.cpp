@@ -0,0 +1,374 @@
+#include "VehicleDiagnostics.h"
+#include "VehicleDiagnosticsPubSubTypes.h"
+#include "RenderQueue.hpp"
+#include "TerminalFrame.hpp"
+#include "LatencyHistogram.hpp"
+#include "ProcessMemory.hpp"
+
+#include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastdds/dds/domain/DomainParticipant.hpp>
+#include <fastdds/dds/topic/TypeSupport.hpp>
+#include <fastdds/dds/subscriber/Subscriber.hpp>
+#include <fastdds/dds/subscriber/DataReader.hpp>
+#include <fastdds/dds/subscriber/DataReaderListener.hpp>
+#include <fastdds/dds/subscriber/qos/DataReaderQos.hpp>
+#include <fastdds/dds/subscriber/SampleInfo.hpp>
+#include <fastdds/dds/core/LoanableSequence.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastdds::dds;
+
+struct FleetSubscriberOptions {
+    int32_t depth;         // KEEP_LAST samples kept per vehicle
+    size_t max_instances;  // vehicles the reader can hold
+    bool read;             // read_next_instance (samples stay in the reader) instead of take
+    size_t rows;           // vehicles shown in the table
+
+    FleetSubscriberOptions()
+        : depth(1)
+        , max_instances(10000)
+        , read(false)
+        , rows(10) {}
+};
+
+// Latest state per vehicle, filled instance by instance on the receive thread
+class FleetListener : public DataReaderListener {
+public:
+    struct VehicleState {
+        eprosima::fastcdr::fixed_string<17> vin;
+        float engine_rpm;
+        float vehicle_speed;
+        float engine_temperature;
+        float fuel_level;
+        float battery_voltage;
+        size_t error_codes;
+        bool alive;
+        uint64_t samples;
+    };
+
+private:
+    bool read_;
+    std::map<InstanceHandle_t, VehicleState> fleet_;
+    LatencyHistogram instance_ns_;  // per-instance read/take cost in the window
+    uint64_t samples_;              // in the window
+    uint64_t passes_;
+    uint64_t instances_visited_;
+    mutable std::mutex mutex_;
+
+    void update(const VehicleDiagnostics& data, const SampleInfo& info) {
+        VehicleState& state = fleet_[info.instance_handle];
+        if (info.instance_state != ALIVE_INSTANCE_STATE) {
+            state.alive = false;  // disposed or no writers left
+        }
+        if (!info.valid_data) return;
+
+        state.vin = data.vehicle_id();
+        state.engine_rpm = data.engine_rpm();
+        state.vehicle_speed = data.vehicle_speed();
+        state.engine_temperature = data.engine_temperature();
+        state.fuel_level = data.fuel_level();
+        state.battery_voltage = data.battery_voltage();
+        state.error_codes = data.error_codes().size();
+        state.alive = true;
+        state.samples++;
+        samples_++;
+    }
+
+public:
+    explicit FleetListener(bool read)
+        : read_(read)
+        , samples_(0)
+        , passes_(0)
+        , instances_visited_(0) {
+    }
+
+    // Walks the instances with new samples one by one. Each call returns the
+    // samples of the next instance after 'previous', so a vehicle's history
+    // (at most KEEP_LAST depth samples) is handled as one group.
+    void on_data_available(DataReader* reader) override {
+        LoanableSequence<VehicleDiagnostics> samples;
+        SampleInfoSeq infos;
+        InstanceHandle_t previous = HANDLE_NIL;
+        size_t instances = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        for (;;) {
+            ReturnCode_t ret = read_
+                    ? reader->read_next_instance(samples, infos, LENGTH_UNLIMITED, previous, NOT_READ_SAMPLE_STATE)
+                    : reader->take_next_instance(samples, infos, LENGTH_UNLIMITED, previous);
+            if (ret != ReturnCode_t::RETCODE_OK) break;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (LoanableCollection::size_type i = 0; i < samples.length(); ++i) {
+                    update(samples[i], infos[i]);
+                }
+            }
+            previous = infos[0].instance_handle;
+            reader->return_loan(samples, infos);
+            ++instances;
+        }
+
+        if (instances == 0) return;
+        uint64_t elapsed_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+        std::lock_guard<std::mutex> lock(mutex_);
+        instance_ns_.record(elapsed_ns / instances);
+        passes_++;
+        instances_visited_ += instances;
+    }
+
+    struct Snapshot {
+        size_t vehicles;
+        size_t alive;
+        size_t overheating;  // vehicles reporting error codes
+        uint64_t samples;
+        uint64_t passes;
+        uint64_t instances_visited;
+        LatencyHistogram instance_ns;
+        std::vector<VehicleState> hottest;
+    };
+
+    // Copies the counters of the last window and the 'rows' hottest engines
+    void take_snapshot(size_t rows, Snapshot& out) {
+        std::vector<const VehicleState*> states;
+        std::lock_guard<std::mutex> lock(mutex_);
+        out.vehicles = fleet_.size();
+        out.alive = 0;
+        out.overheating = 0;
+        states.reserve(fleet_.size());
+        for (const auto& entry : fleet_) {
+            const VehicleState& state = entry.second;
+            if (state.alive) out.alive++;
+            if (state.error_codes > 0) out.overheating++;
+            states.push_back(&state);
+        }
+        size_t shown = std::min(rows, states.size());
+        std::partial_sort(states.begin(), states.begin() + shown, states.end(),
+            [](const VehicleState* a, const VehicleState* b) {
+                return a->engine_temperature > b->engine_temperature;
+            });
+        out.hottest.clear();
+        for (size_t i = 0; i < shown; ++i) {
+            out.hottest.push_back(*states[i]);
+        }
+
+        out.samples = samples_;
+        out.passes = passes_;
+        out.instances_visited = instances_visited_;
+        out.instance_ns = instance_ns_;
+        samples_ = passes_ = instances_visited_ = 0;
+        instance_ns_.reset();
+    }
+};
+
+class VehicleFleetSubscriber {
+private:
+    FleetSubscriberOptions options_;
+    DomainParticipant* participant_;
+    Subscriber* subscriber_;
+    Topic* topic_;
+    DataReader* reader_;
+    TypeSupport type_;
+    FleetListener listener_;
+    TerminalFrame frame_;
+    FleetListener::Snapshot snapshot_;
+    size_t rss_baseline_;
+    std::chrono::steady_clock::time_point last_frame_;
+    // Declared after everything render_frame() uses, so it is destroyed (and
+    // its thread joined after the final frame) first
+    RenderLoop render_loop_;
+
+    void render_frame() {
+        listener_.take_snapshot(options_.rows, snapshot_);
+        auto now = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(now - last_frame_).count();
+        last_frame_ = now;
+        if (seconds <= 0.0) return;
+
+        size_t rss = resident_bytes();
+        size_t grown = rss > rss_baseline_ ? rss - rss_baseline_ : 0;
+
+        std::ostream& out = frame_.begin();
+        out << "=== Vehicle Fleet (KEEP_LAST " << options_.depth << " per vehicle, "
+            << (options_.read ? "read_next_instance" : "take_next_instance") << ") ===\n"
+            << "Vehicles: " << snapshot_.alive << " alive / " << snapshot_.vehicles << " seen"
+            << " (max_instances " << options_.max_instances << ")\n"
+            << std::fixed << std::setprecision(1)
+            << "Samples/s: " << snapshot_.samples / seconds
+            << "   instances per on_data_available: "
+            << (snapshot_.passes > 0 ? static_cast<double>(snapshot_.instances_visited) / snapshot_.passes : 0.0)
+            << "\n"
+            << "Per-instance " << (options_.read ? "read" : "take") << ": p50 "
+            << snapshot_.instance_ns.percentile(50.0) / 1000.0 << " us, p99 "
+            << snapshot_.instance_ns.percentile(99.0) / 1000.0 << " us\n"
+            << "Memory: RSS +" << grown / 1024 << " KB since the reader was created";
+        if (snapshot_.vehicles > 0) {
+            out << ", ~" << grown / snapshot_.vehicles << " bytes per vehicle";
+        }
+        out << "\n"
+            << "Overheating (error codes active): " << snapshot_.overheating << " vehicles\n\n";
+
+        out << std::left << std::setw(19) << "Hottest engines" << std::right
+            << std::setw(8) << "RPM" << std::setw(8) << "km/h" << std::setw(8) << "Temp"
+            << std::setw(8) << "Fuel%" << std::setw(7) << "V" << std::setw(5) << "DTC"
+            << std::setw(10) << "Samples" << "\n";
+        for (const auto& state : snapshot_.hottest) {
+            out << std::left << std::setw(19) << state.vin.c_str() << std::right
+                << std::setw(8) << state.engine_rpm << std::setw(8) << state.vehicle_speed
+                << std::setw(8) << state.engine_temperature << std::setw(8) << state.fuel_level
+                << std::setw(7) << state.battery_voltage << std::setw(5) << state.error_codes
+                << std::setw(10) << state.samples << (state.alive ? "" : "  (gone)") << "\n";
+        }
+        out << "\nPress Enter to stop.\n";
+        frame_.present();
+    }
+
+public:
+    explicit VehicleFleetSubscriber(const FleetSubscriberOptions& options)
+        : options_(options)
+        , participant_(nullptr)
+        , subscriber_(nullptr)
+        , topic_(nullptr)
+        , reader_(nullptr)
+        , type_(new VehicleDiagnosticsPubSubType())
+        , listener_(options.read)
+        , rss_baseline_(0)
+        , render_loop_(1.0) {
+    }
+
+    ~VehicleFleetSubscriber() {
+        if (participant_ != nullptr) {
+            if (subscriber_ != nullptr && reader_ != nullptr)
+                subscriber_->delete_datareader(reader_);
+            if (subscriber_ != nullptr)
+                participant_->delete_subscriber(subscriber_);
+            if (topic_ != nullptr)
+                participant_->delete_topic(topic_);
+            DomainParticipantFactory::get_instance()->delete_participant(participant_);
+        }
+    }
+
+    bool init() {
+        DomainParticipantQos participantQos;
+        participantQos.name("VehicleFleet_Subscriber");
+
+        participant_ = DomainParticipantFactory::get_instance()->create_participant(0, participantQos);
+        if (participant_ == nullptr) return false;
+
+        type_.register_type(participant_);
+
+        subscriber_ = participant_->create_subscriber(SUBSCRIBER_QOS_DEFAULT);
+        if (subscriber_ == nullptr) return false;
+
+        topic_ = participant_->create_topic("VehicleDiagnosticsTopic", "VehicleDiagnostics", TOPIC_QOS_DEFAULT);
+        if (topic_ == nullptr) return false;
+
+        // KEEP_LAST applies per instance: 'depth' samples for every vehicle.
+        // The default resource limits allow only 10 instances.
+        DataReaderQos qos = DATAREADER_QOS_DEFAULT;
+        qos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+        qos.history().kind = KEEP_LAST_HISTORY_QOS;
+        qos.history().depth = options_.depth;
+        // main() keeps max_instances * depth within int32_t
+        qos.resource_limits().max_instances = static_cast<int32_t>(options_.max_instances);
+        qos.resource_limits().max_samples_per_instance = options_.depth;
+        qos.resource_limits().max_samples = static_cast<int32_t>(options_.max_instances) * options_.depth;
+
+        reader_ = subscriber_->create_datareader(topic_, qos, &listener_);
+        if (reader_ == nullptr) return false;
+
+        rss_baseline_ = resident_bytes();
+        return true;
+    }
+
+    void run() {
+        last_frame_ = std::chrono::steady_clock::now();
+        render_loop_.start([this]() { render_frame(); });
+        std::string line;
+        std::getline(std::cin, line);
+        render_loop_.stop();
+    }
+};
+
+// Parses a whole decimal number in [min, max]
+static bool parse_count(const char* text, long long min, long long max, long long& value) {
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtoll(text, &end, 10);
+    return end != text && *end == '\0' && errno == 0 && value >= min && value <= max;
+}
+
+static void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --depth <n>         : KEEP_LAST depth per vehicle (default 1)\n"
+              << "  --max-instances <n> : Vehicles the reader holds (default 10000)\n"
+              << "  --read              : read_next_instance on NOT_READ samples instead of take_next_instance\n"
+              << "  --rows <n>          : Vehicles shown\n";
+}
+
+int main(int argc, char** argv) {
+    try {
+        // max_instances, max_samples_per_instance and max_samples of the reader are int32_t
+        const long long int32_max = std::numeric_limits<int32_t>::max();
+        FleetSubscriberOptions options;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            long long value = 0;
+            if (arg == "--depth" && i + 1 < argc) {
+                if (!parse_count(argv[++i], 1, int32_max, value)) {
+                    std::cout << "Invalid --depth: " << argv[i] << std::endl;
+                    return 1;
+                }
+                options.depth = static_cast<int32_t>(value);
+            } else if (arg == "--max-instances" && i + 1 < argc) {
+                if (!parse_count(argv[++i], 1, int32_max, value)) {
+                    std::cout << "Invalid --max-instances: " << argv[i] << std::endl;
+                    return 1;
+                }
+                options.max_instances = static_cast<size_t>(value);
+            } else if (arg == "--read") {
+                options.read = true;
+            } else if (arg == "--rows" && i + 1 < argc) {
+                if (!parse_count(argv[++i], 0, std::numeric_limits<long long>::max(), value)) {
+                    std::cout << "Invalid --rows: " << argv[i] << std::endl;
+                    return 1;
+                }
+                options.rows = static_cast<size_t>(value);
+            } else {
+                print_usage(argv[0]);
+                return 1;
+            }
+        }
+
+        // Both factors are at most INT32_MAX, so the product fits in long long
+        if (static_cast<long long>(options.max_instances) * options.depth > int32_max) {
+            std::cout << "--max-instances x --depth must not exceed " << int32_max
+                      << " samples (max_samples)" << std::endl;
+            return 1;
+        }
+
+        VehicleFleetSubscriber subscriber(options);
+        if (subscriber.init()) {
+            subscriber.run();
+        }
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
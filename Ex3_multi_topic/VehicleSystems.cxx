@@ -332,7 +332,7 @@ float& PowertrainData::throttle_position()
  * @param _dtc_codes New value to be copied in member dtc_codes
  */
 void PowertrainData::dtc_codes(
-        const std::vector<std::string>& _dtc_codes)
+        const std::vector<eprosima::fastcdr::fixed_string<8>>& _dtc_codes)
 {
     m_dtc_codes = _dtc_codes;
 }
@@ -342,7 +342,7 @@ void PowertrainData::dtc_codes(
  * @param _dtc_codes New value to be moved in member dtc_codes
  */
 void PowertrainData::dtc_codes(
-        std::vector<std::string>&& _dtc_codes)
+        std::vector<eprosima::fastcdr::fixed_string<8>>&& _dtc_codes)
 {
     m_dtc_codes = std::move(_dtc_codes);
 }
@@ -351,7 +351,7 @@ void PowertrainData::dtc_codes(
  * @brief This function returns a constant reference to member dtc_codes
  * @return Constant reference to member dtc_codes
  */
-const std::vector<std::string>& PowertrainData::dtc_codes() const
+const std::vector<eprosima::fastcdr::fixed_string<8>>& PowertrainData::dtc_codes() const
 {
     return m_dtc_codes;
 }
@@ -360,7 +360,7 @@ const std::vector<std::string>& PowertrainData::dtc_codes() const
  * @brief This function returns a reference to member dtc_codes
  * @return Reference to member dtc_codes
  */
-std::vector<std::string>& PowertrainData::dtc_codes()
+std::vector<eprosima::fastcdr::fixed_string<8>>& PowertrainData::dtc_codes()
 {
     return m_dtc_codes;
 }
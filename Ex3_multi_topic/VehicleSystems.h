@@ -277,26 +277,26 @@ public:
      * @param _dtc_codes New value to be copied in member dtc_codes
      */
     eProsima_user_DllExport void dtc_codes(
-            const std::vector<std::string>& _dtc_codes);
+            const std::vector<eprosima::fastcdr::fixed_string<8>>& _dtc_codes);
 
     /*!
      * @brief This function moves the value in member dtc_codes
      * @param _dtc_codes New value to be moved in member dtc_codes
      */
     eProsima_user_DllExport void dtc_codes(
-            std::vector<std::string>&& _dtc_codes);
+            std::vector<eprosima::fastcdr::fixed_string<8>>&& _dtc_codes);
 
     /*!
      * @brief This function returns a constant reference to member dtc_codes
      * @return Constant reference to member dtc_codes
      */
-    eProsima_user_DllExport const std::vector<std::string>& dtc_codes() const;
+    eProsima_user_DllExport const std::vector<eprosima::fastcdr::fixed_string<8>>& dtc_codes() const;
 
     /*!
      * @brief This function returns a reference to member dtc_codes
      * @return Reference to member dtc_codes
      */
-    eProsima_user_DllExport std::vector<std::string>& dtc_codes();
+    eProsima_user_DllExport std::vector<eprosima::fastcdr::fixed_string<8>>& dtc_codes();
 
 private:
 
@@ -307,7 +307,7 @@ private:
     float m_transmission_temp{0.0};
     int32_t m_current_gear{0};
     float m_throttle_position{0.0};
-    std::vector<std::string> m_dtc_codes;
+    std::vector<eprosima::fastcdr::fixed_string<8>> m_dtc_codes;
 
 };
 
@@ -24,16 +24,16 @@
 
 #include "VehicleSystems.h"
 
-constexpr uint32_t ChassisData_max_cdr_typesize {74UL};
+constexpr uint32_t ChassisData_max_cdr_typesize {66UL};
 constexpr uint32_t ChassisData_max_key_cdr_typesize {0UL};
 
-constexpr uint32_t PowertrainData_max_cdr_typesize {26048UL};
+constexpr uint32_t PowertrainData_max_cdr_typesize {301UL};
 constexpr uint32_t PowertrainData_max_key_cdr_typesize {0UL};
 
-constexpr uint32_t BatteryData_max_cdr_typesize {41UL};
+constexpr uint32_t BatteryData_max_cdr_typesize {33UL};
 constexpr uint32_t BatteryData_max_key_cdr_typesize {0UL};
 
-constexpr uint32_t ADASData_max_cdr_typesize {440UL};
+constexpr uint32_t ADASData_max_cdr_typesize {104UL};
 constexpr uint32_t ADASData_max_key_cdr_typesize {0UL};
 
 
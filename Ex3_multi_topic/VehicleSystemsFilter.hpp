@@ -0,0 +1,420 @@
+#ifndef DDS_PRACTICE_EX3_VEHICLESYSTEMSFILTER_HPP_
+#define DDS_PRACTICE_EX3_VEHICLESYSTEMSFILTER_HPP_
+
+#include "VehicleSystems.h"
+
+#include <fastdds/dds/topic/IContentFilter.hpp>
+#include <fastdds/dds/topic/IContentFilterFactory.hpp>
+#include <fastdds/dds/topic/TopicDataType.hpp>
+
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Content filter for the VehicleSystems topics, registered on the participants
+// as kVehicleFilterClass. The generated types carry no TypeObject, which the
+// built-in DDSSQL filter needs, so this class implements the part of the SQL
+// filter syntax the examples use:
+//
+//   <field> <op> <value> [AND|OR <field> <op> <value> ...]
+//
+// op is one of = <> != < <= > >=, value a number, TRUE/FALSE or %n (the n-th
+// expression parameter). AND binds tighter than OR; there are no parentheses.
+// Fields are the scalar members of a type (booleans compare as 0/1), e.g.
+// "engine_temperature > 90", "abs_active = TRUE", "forward_collision_warning = TRUE".
+//
+// The same factory evaluates the filters of local readers (reader side) and,
+// when it is registered on the writer's participant, the filters of matched
+// remote readers (writer side): samples that do not pass are then never sent.
+const char* const kVehicleFilterClass = "VEHICLE_FILTER";
+
+template<typename T>
+struct VehicleFilterField {
+    const char* name;
+    double (*get)(const T&);
+};
+
+template<typename T> struct VehicleFilterFields;
+
+template<> struct VehicleFilterFields<PowertrainData> {
+    static std::vector<VehicleFilterField<PowertrainData>> list() {
+        return {
+            {"timestamp", [](const PowertrainData& d) { return static_cast<double>(d.timestamp()); }},
+            {"engine_rpm", [](const PowertrainData& d) { return static_cast<double>(d.engine_rpm()); }},
+            {"engine_temperature", [](const PowertrainData& d) { return static_cast<double>(d.engine_temperature()); }},
+            {"engine_load", [](const PowertrainData& d) { return static_cast<double>(d.engine_load()); }},
+            {"transmission_temp", [](const PowertrainData& d) { return static_cast<double>(d.transmission_temp()); }},
+            {"current_gear", [](const PowertrainData& d) { return static_cast<double>(d.current_gear()); }},
+            {"throttle_position", [](const PowertrainData& d) { return static_cast<double>(d.throttle_position()); }},
+        };
+    }
+};
+
+template<> struct VehicleFilterFields<ChassisData> {
+    static std::vector<VehicleFilterField<ChassisData>> list() {
+        return {
+            {"timestamp", [](const ChassisData& d) { return static_cast<double>(d.timestamp()); }},
+            {"brake_pressure", [](const ChassisData& d) { return static_cast<double>(d.brake_pressure()); }},
+            {"steering_angle", [](const ChassisData& d) { return static_cast<double>(d.steering_angle()); }},
+            {"abs_active", [](const ChassisData& d) { return d.abs_active() ? 1.0 : 0.0; }},
+            {"traction_control_active", [](const ChassisData& d) { return d.traction_control_active() ? 1.0 : 0.0; }},
+        };
+    }
+};
+
+template<> struct VehicleFilterFields<BatteryData> {
+    static std::vector<VehicleFilterField<BatteryData>> list() {
+        return {
+            {"timestamp", [](const BatteryData& d) { return static_cast<double>(d.timestamp()); }},
+            {"voltage", [](const BatteryData& d) { return static_cast<double>(d.voltage()); }},
+            {"current", [](const BatteryData& d) { return static_cast<double>(d.current()); }},
+            {"temperature", [](const BatteryData& d) { return static_cast<double>(d.temperature()); }},
+            {"state_of_charge", [](const BatteryData& d) { return static_cast<double>(d.state_of_charge()); }},
+            {"power_consumption", [](const BatteryData& d) { return static_cast<double>(d.power_consumption()); }},
+            {"charging_cycles", [](const BatteryData& d) { return static_cast<double>(d.charging_cycles()); }},
+            {"charging_status", [](const BatteryData& d) { return d.charging_status() ? 1.0 : 0.0; }},
+        };
+    }
+};
+
+template<> struct VehicleFilterFields<ADASData> {
+    static std::vector<VehicleFilterField<ADASData>> list() {
+        return {
+            {"timestamp", [](const ADASData& d) { return static_cast<double>(d.timestamp()); }},
+            {"forward_collision_distance", [](const ADASData& d) { return static_cast<double>(d.forward_collision_distance()); }},
+            {"lane_deviation", [](const ADASData& d) { return static_cast<double>(d.lane_deviation()); }},
+            {"lane_departure_warning", [](const ADASData& d) { return d.lane_departure_warning() ? 1.0 : 0.0; }},
+            {"forward_collision_warning", [](const ADASData& d) { return d.forward_collision_warning() ? 1.0 : 0.0; }},
+            {"blind_spot_warning_left", [](const ADASData& d) { return d.blind_spot_warning_left() ? 1.0 : 0.0; }},
+            {"blind_spot_warning_right", [](const ADASData& d) { return d.blind_spot_warning_right() ? 1.0 : 0.0; }},
+            {"adaptive_cruise_speed", [](const ADASData& d) { return static_cast<double>(d.adaptive_cruise_speed()); }},
+            {"time_to_collision", [](const ADASData& d) { return static_cast<double>(d.time_to_collision()); }},
+        };
+    }
+};
+
+// Evaluation counters of all filters of one type. Sizes are serialized
+// payload bytes, RTPS headers not included.
+struct VehicleFilterCounters {
+    std::atomic<uint64_t> evaluated;
+    std::atomic<uint64_t> passed;
+    std::atomic<uint64_t> evaluated_bytes;
+    std::atomic<uint64_t> passed_bytes;
+
+    VehicleFilterCounters()
+        : evaluated(0)
+        , passed(0)
+        , evaluated_bytes(0)
+        , passed_bytes(0) {}
+
+    void add(uint32_t bytes, bool pass) {
+        evaluated.fetch_add(1, std::memory_order_relaxed);
+        evaluated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        if (pass) {
+            passed.fetch_add(1, std::memory_order_relaxed);
+            passed_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    }
+};
+
+// Parsed filter expression, independent of the sample type
+class VehicleFilterExpression {
+public:
+    enum Op { EQ, NE, LT, LE, GT, GE };
+
+    struct Condition {
+        size_t field;   // index into the type's field list
+        Op op;
+        int parameter;  // -1: literal value
+        double value;
+    };
+
+    // Parses expression against the field names; false on a syntax error,
+    // an unknown field or a parameter index without a parameter
+    bool parse(const std::string& expression, const std::vector<std::string>& fields,
+               const std::vector<std::string>& parameters) {
+        std::vector<std::string> tokens;
+        if (!tokenize(expression, tokens) || tokens.empty()) return false;
+
+        std::vector<std::vector<Condition>> any_of(1);
+        size_t i = 0;
+        while (true) {
+            if (i + 3 > tokens.size()) return false;
+            Condition condition;
+            if (!find_field(tokens[i], fields, condition.field) ||
+                !parse_op(tokens[i + 1], condition.op) ||
+                !parse_operand(tokens[i + 2], condition)) {
+                return false;
+            }
+            any_of.back().push_back(condition);
+            i += 3;
+            if (i == tokens.size()) break;
+
+            std::string keyword = upper(tokens[i++]);
+            if (keyword == "OR") any_of.emplace_back();
+            else if (keyword != "AND") return false;
+        }
+
+        any_of_.swap(any_of);
+        return set_parameters(parameters);
+    }
+
+    // Resolves the %n operands; false if one has no (numeric) parameter
+    bool set_parameters(const std::vector<std::string>& parameters) {
+        for (auto& all_of : any_of_) {
+            for (auto& condition : all_of) {
+                if (condition.parameter < 0) continue;
+                if (static_cast<size_t>(condition.parameter) >= parameters.size() ||
+                    !parse_value(parameters[condition.parameter], condition.value)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    template<typename Get>
+    bool matches(Get get) const {
+        for (const auto& all_of : any_of_) {
+            bool pass = true;
+            for (const auto& condition : all_of) {
+                if (!compare(get(condition.field), condition.op, condition.value)) {
+                    pass = false;
+                    break;
+                }
+            }
+            if (pass) return true;
+        }
+        return false;
+    }
+
+private:
+    std::vector<std::vector<Condition>> any_of_;  // OR of ANDed conditions
+
+    static std::string upper(std::string text) {
+        for (auto& c : text) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        return text;
+    }
+
+    static bool tokenize(const std::string& text, std::vector<std::string>& tokens) {
+        size_t i = 0;
+        while (i < text.size()) {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+            if (std::isspace(c)) {
+                ++i;
+            } else if (c == '<' || c == '>' || c == '=' || c == '!') {
+                size_t length = (i + 1 < text.size() && (text[i + 1] == '=' || (c == '<' && text[i + 1] == '>'))) ? 2 : 1;
+                tokens.push_back(text.substr(i, length));
+                i += length;
+            } else if (c == '\'') {
+                // Quoted literal: '90'
+                size_t end = text.find('\'', i + 1);
+                if (end == std::string::npos) return false;
+                tokens.push_back(text.substr(i + 1, end - i - 1));
+                i = end + 1;
+            } else {
+                size_t start = i;
+                while (i < text.size() && !std::isspace(static_cast<unsigned char>(text[i])) &&
+                       std::string("<>=!'").find(text[i]) == std::string::npos) {
+                    ++i;
+                }
+                tokens.push_back(text.substr(start, i - start));
+            }
+        }
+        return true;
+    }
+
+    static bool find_field(const std::string& name, const std::vector<std::string>& fields, size_t& index) {
+        for (index = 0; index < fields.size(); ++index) {
+            if (fields[index] == name) return true;
+        }
+        return false;
+    }
+
+    static bool parse_op(const std::string& token, Op& op) {
+        if (token == "=") op = EQ;
+        else if (token == "<>" || token == "!=") op = NE;
+        else if (token == "<") op = LT;
+        else if (token == "<=") op = LE;
+        else if (token == ">") op = GT;
+        else if (token == ">=") op = GE;
+        else return false;
+        return true;
+    }
+
+    static bool parse_value(const std::string& token, double& value) {
+        std::string keyword = upper(token);
+        if (keyword == "TRUE") value = 1.0;
+        else if (keyword == "FALSE") value = 0.0;
+        else {
+            char* end = nullptr;
+            value = std::strtod(token.c_str(), &end);
+            return !token.empty() && *end == '\0';
+        }
+        return true;
+    }
+
+    static bool parse_operand(const std::string& token, Condition& condition) {
+        condition.parameter = -1;
+        condition.value = 0.0;
+        if (token.size() > 1 && token[0] == '%') {
+            char* end = nullptr;
+            long index = std::strtol(token.c_str() + 1, &end, 10);
+            if (*end != '\0' || index < 0 || index > 99) return false;
+            condition.parameter = static_cast<int>(index);
+            return true;
+        }
+        return parse_value(token, condition.value);
+    }
+
+    static bool compare(double field, Op op, double value) {
+        switch (op) {
+            case EQ: return field == value;
+            case NE: return field != value;
+            case LT: return field < value;
+            case LE: return field <= value;
+            case GT: return field > value;
+            case GE: return field >= value;
+        }
+        return false;
+    }
+};
+
+// Filter instance behind one ContentFilteredTopic (reader side) or one
+// matched filtered reader (writer side)
+class VehicleContentFilter : public eprosima::fastdds::dds::IContentFilter {
+public:
+    virtual ~VehicleContentFilter() {}
+    virtual bool set_parameters(const std::vector<std::string>& parameters) = 0;
+};
+
+template<typename T>
+class TypedVehicleContentFilter : public VehicleContentFilter {
+private:
+    eprosima::fastdds::dds::TopicDataType* type_;
+    std::vector<VehicleFilterField<T>> fields_;
+    VehicleFilterExpression expression_;
+    VehicleFilterCounters& counters_;
+
+    // evaluate() can be called from several writing/receiving threads;
+    // the sample is reused, so deserializing does not allocate per call
+    mutable std::mutex mutex_;
+    mutable T sample_;
+
+public:
+    TypedVehicleContentFilter(const eprosima::fastdds::dds::TopicDataType* type, VehicleFilterCounters& counters)
+        : type_(const_cast<eprosima::fastdds::dds::TopicDataType*>(type))
+        , fields_(VehicleFilterFields<T>::list())
+        , counters_(counters) {}
+
+    bool parse(const std::string& expression, const std::vector<std::string>& parameters) {
+        std::vector<std::string> names;
+        for (const auto& field : fields_) names.push_back(field.name);
+        return expression_.parse(expression, names, parameters);
+    }
+
+    bool set_parameters(const std::vector<std::string>& parameters) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return expression_.set_parameters(parameters);
+    }
+
+    bool evaluate(const SerializedPayload& payload, const FilterSampleInfo&, const GUID_t&) const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // deserialize() only reads the payload
+        bool pass = type_->deserialize(const_cast<SerializedPayload*>(&payload), &sample_) &&
+                    expression_.matches([this](size_t field) { return fields_[field].get(sample_); });
+        counters_.add(payload.length, pass);
+        return pass;
+    }
+};
+
+// Creates the filters of kVehicleFilterClass for the four VehicleSystems types
+// and keeps their counters per type name. Must outlive the participants it is
+// registered on.
+class VehicleFilterFactory : public eprosima::fastdds::dds::IContentFilterFactory {
+private:
+    std::map<std::string, std::unique_ptr<VehicleFilterCounters>> counters_;
+
+    static std::vector<std::string> to_vector(const ParameterSeq& parameters) {
+        std::vector<std::string> values;
+        for (ParameterSeq::size_type i = 0; i < parameters.length(); ++i) {
+            values.push_back(parameters[i] != nullptr ? parameters[i] : "");
+        }
+        return values;
+    }
+
+    template<typename T>
+    VehicleContentFilter* create(const eprosima::fastdds::dds::TopicDataType* type, const char* type_name,
+                                 const char* expression, const std::vector<std::string>& parameters) {
+        std::unique_ptr<TypedVehicleContentFilter<T>> filter(
+            new TypedVehicleContentFilter<T>(type, *counters_[type_name]));
+        if (!filter->parse(expression, parameters)) return nullptr;
+        return filter.release();
+    }
+
+public:
+    VehicleFilterFactory() {
+        for (const char* type_name : {"PowertrainData", "ChassisData", "BatteryData", "ADASData"}) {
+            counters_[type_name].reset(new VehicleFilterCounters());
+        }
+    }
+
+    // Counters of a type name; the map is fixed after construction
+    const VehicleFilterCounters* counters(const std::string& type_name) const {
+        auto it = counters_.find(type_name);
+        return it != counters_.end() ? it->second.get() : nullptr;
+    }
+
+    eprosima::fastdds::dds::ReturnCode_t create_content_filter(
+            const char* filter_class_name, const char* type_name,
+            const eprosima::fastdds::dds::TopicDataType* data_type, const char* filter_expression,
+            const ParameterSeq& filter_parameters,
+            eprosima::fastdds::dds::IContentFilter*& filter_instance) override {
+        using eprosima::fastdds::dds::ReturnCode_t;
+
+        if (std::string(filter_class_name) != kVehicleFilterClass || data_type == nullptr) {
+            return ReturnCode_t::RETCODE_BAD_PARAMETER;
+        }
+        std::vector<std::string> parameters = to_vector(filter_parameters);
+
+        // No expression: only the parameters of an existing filter change
+        if (filter_expression == nullptr) {
+            auto filter = dynamic_cast<VehicleContentFilter*>(filter_instance);
+            return filter != nullptr && filter->set_parameters(parameters)
+                   ? ReturnCode_t::RETCODE_OK : ReturnCode_t::RETCODE_BAD_PARAMETER;
+        }
+
+        std::string type(type_name);
+        VehicleContentFilter* filter = nullptr;
+        if (type == "PowertrainData") filter = create<PowertrainData>(data_type, type_name, filter_expression, parameters);
+        else if (type == "ChassisData") filter = create<ChassisData>(data_type, type_name, filter_expression, parameters);
+        else if (type == "BatteryData") filter = create<BatteryData>(data_type, type_name, filter_expression, parameters);
+        else if (type == "ADASData") filter = create<ADASData>(data_type, type_name, filter_expression, parameters);
+        if (filter == nullptr) return ReturnCode_t::RETCODE_BAD_PARAMETER;
+
+        // Replacing the expression of an existing filter
+        delete dynamic_cast<VehicleContentFilter*>(filter_instance);
+        filter_instance = filter;
+        return ReturnCode_t::RETCODE_OK;
+    }
+
+    eprosima::fastdds::dds::ReturnCode_t delete_content_filter(
+            const char* filter_class_name,
+            eprosima::fastdds::dds::IContentFilter* filter_instance) override {
+        using eprosima::fastdds::dds::ReturnCode_t;
+
+        if (std::string(filter_class_name) != kVehicleFilterClass) {
+            return ReturnCode_t::RETCODE_BAD_PARAMETER;
+        }
+        delete dynamic_cast<VehicleContentFilter*>(filter_instance);
+        return ReturnCode_t::RETCODE_OK;
+    }
+};
+
+#endif  // DDS_PRACTICE_EX3_VEHICLESYSTEMSFILTER_HPP_
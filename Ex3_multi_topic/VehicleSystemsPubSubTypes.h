@@ -95,7 +95,7 @@ public:
 #ifdef TOPIC_DATA_TYPE_API_HAS_IS_BOUNDED
     eProsima_user_DllExport inline bool is_bounded() const override
     {
-        return false;
+        return true;
     }
 
 #endif  // TOPIC_DATA_TYPE_API_HAS_IS_BOUNDED
@@ -132,6 +132,39 @@ public:
 
 
 
+#ifndef SWIG
+namespace detail {
+
+template<typename Tag, typename Tag::type M>
+struct ChassisData_rob
+{
+    friend constexpr typename Tag::type get(
+            Tag)
+    {
+        return M;
+    }
+
+};
+
+struct ChassisData_f
+{
+    typedef bool ChassisData::* type;
+    friend constexpr type get(
+            ChassisData_f);
+};
+
+template struct ChassisData_rob<ChassisData_f, &ChassisData::m_traction_control_active>;
+
+template <typename T, typename Tag>
+inline size_t constexpr ChassisData_offset_of()
+{
+    return ((::size_t) &reinterpret_cast<char const volatile&>((((T*)0)->*get(Tag()))));
+}
+
+} // namespace detail
+#endif // ifndef SWIG
+
+
 /*!
  * @brief This class represents the TopicDataType of the type ChassisData defined by the user in the IDL file.
  * @ingroup VehicleSystems
@@ -193,14 +226,20 @@ public:
 #ifdef TOPIC_DATA_TYPE_API_HAS_IS_PLAIN
     eProsima_user_DllExport inline bool is_plain() const override
     {
-        return false;
+        return is_plain_xcdrv1_impl();
     }
 
     eProsima_user_DllExport inline bool is_plain(
         eprosima::fastdds::dds::DataRepresentationId_t data_representation) const override
     {
-        static_cast<void>(data_representation);
-        return false;
+        if(data_representation == eprosima::fastdds::dds::DataRepresentationId_t::XCDR2_DATA_REPRESENTATION)
+        {
+            return is_plain_xcdrv2_impl();
+        }
+        else
+        {
+            return is_plain_xcdrv1_impl();
+        }
     }
 
 #endif  // TOPIC_DATA_TYPE_API_HAS_IS_PLAIN
@@ -209,8 +248,8 @@ public:
     eProsima_user_DllExport inline bool construct_sample(
             void* memory) const override
     {
-        static_cast<void>(memory);
-        return false;
+        new (memory) ChassisData();
+        return true;
     }
 
 #endif  // TOPIC_DATA_TYPE_API_HAS_CONSTRUCT_SAMPLE
@@ -218,10 +257,60 @@ public:
     MD5 m_md5;
     unsigned char* m_keyBuffer;
 
+
+private:
+
+    static constexpr bool is_plain_xcdrv1_impl()
+    {
+        return 66ULL ==
+               (detail::ChassisData_offset_of<ChassisData, detail::ChassisData_f>() +
+               sizeof(bool));
+    }
+
+    static constexpr bool is_plain_xcdrv2_impl()
+    {
+        return 66ULL ==
+               (detail::ChassisData_offset_of<ChassisData, detail::ChassisData_f>() +
+               sizeof(bool));
+    }
+
 };
 
 
 
+#ifndef SWIG
+namespace detail {
+
+template<typename Tag, typename Tag::type M>
+struct BatteryData_rob
+{
+    friend constexpr typename Tag::type get(
+            Tag)
+    {
+        return M;
+    }
+
+};
+
+struct BatteryData_f
+{
+    typedef bool BatteryData::* type;
+    friend constexpr type get(
+            BatteryData_f);
+};
+
+template struct BatteryData_rob<BatteryData_f, &BatteryData::m_charging_status>;
+
+template <typename T, typename Tag>
+inline size_t constexpr BatteryData_offset_of()
+{
+    return ((::size_t) &reinterpret_cast<char const volatile&>((((T*)0)->*get(Tag()))));
+}
+
+} // namespace detail
+#endif // ifndef SWIG
+
+
 /*!
  * @brief This class represents the TopicDataType of the type BatteryData defined by the user in the IDL file.
  * @ingroup VehicleSystems
@@ -283,14 +372,20 @@ public:
 #ifdef TOPIC_DATA_TYPE_API_HAS_IS_PLAIN
     eProsima_user_DllExport inline bool is_plain() const override
     {
-        return false;
+        return is_plain_xcdrv1_impl();
     }
 
     eProsima_user_DllExport inline bool is_plain(
         eprosima::fastdds::dds::DataRepresentationId_t data_representation) const override
     {
-        static_cast<void>(data_representation);
-        return false;
+        if(data_representation == eprosima::fastdds::dds::DataRepresentationId_t::XCDR2_DATA_REPRESENTATION)
+        {
+            return is_plain_xcdrv2_impl();
+        }
+        else
+        {
+            return is_plain_xcdrv1_impl();
+        }
     }
 
 #endif  // TOPIC_DATA_TYPE_API_HAS_IS_PLAIN
@@ -299,8 +394,8 @@ public:
     eProsima_user_DllExport inline bool construct_sample(
             void* memory) const override
     {
-        static_cast<void>(memory);
-        return false;
+        new (memory) BatteryData();
+        return true;
     }
 
 #endif  // TOPIC_DATA_TYPE_API_HAS_CONSTRUCT_SAMPLE
@@ -308,6 +403,23 @@ public:
     MD5 m_md5;
     unsigned char* m_keyBuffer;
 
+
+private:
+
+    static constexpr bool is_plain_xcdrv1_impl()
+    {
+        return 33ULL ==
+               (detail::BatteryData_offset_of<BatteryData, detail::BatteryData_f>() +
+               sizeof(bool));
+    }
+
+    static constexpr bool is_plain_xcdrv2_impl()
+    {
+        return 33ULL ==
+               (detail::BatteryData_offset_of<BatteryData, detail::BatteryData_f>() +
+               sizeof(bool));
+    }
+
 };
 
 
@@ -365,7 +477,7 @@ public:
 #ifdef TOPIC_DATA_TYPE_API_HAS_IS_BOUNDED
     eProsima_user_DllExport inline bool is_bounded() const override
     {
-        return false;
+        return true;
     }
 
 #endif  // TOPIC_DATA_TYPE_API_HAS_IS_BOUNDED
@@ -1,184 +1,531 @@
 #include "VehicleSystems.h"
 #include "VehicleSystemsPubSubTypes.h"
+#include "VehicleSystemsFilter.hpp"
+#include "TransportConfig.hpp"
+#include "PeriodicScheduler.hpp"
+#include "SnapshotBuffer.hpp"
+#include "ChangeFilter.hpp"
 
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
 #include <fastdds/dds/domain/DomainParticipant.hpp>
 #include <fastdds/dds/topic/TypeSupport.hpp>
 #include <fastdds/dds/publisher/Publisher.hpp>
 #include <fastdds/dds/publisher/DataWriter.hpp>
+#include <fastdds/dds/publisher/DataWriterListener.hpp>
+#include <fastdds/dds/publisher/qos/DataWriterQos.hpp>
 
 #include <thread>
 #include <chrono>
-#include <mutex>
 #include <atomic>
 #include <random>
 #include <iostream>
+#include <string>
+#include <cstdlib>
+#include <memory>
 #include <map>
+#include <algorithm>
 
 using namespace eprosima::fastdds::dds;
 
+// Per-topic publish rates (Hz), defaults follow typical ECU message rates
+struct TopicRates {
+    double powertrain;
+    double chassis;
+    double battery;
+    double adas;
+
+    TopicRates() : powertrain(50.0), chassis(100.0), battery(10.0), adas(20.0) {}
+
+    bool set(const std::string& topic, double rate_hz) {
+        if (topic == "powertrain") powertrain = rate_hz;
+        else if (topic == "chassis") chassis = rate_hz;
+        else if (topic == "battery") battery = rate_hz;
+        else if (topic == "adas") adas = rate_hz;
+        else return false;
+        return true;
+    }
+};
+
+// Default dead-bands of the change-only mode, around sensor resolution
+static const struct {
+    const char* field;
+    double band;
+} kDefaultDeadBands[] = {
+    {"powertrain.engine_rpm", 25.0},
+    {"powertrain.engine_temperature", 0.5},
+    {"powertrain.engine_load", 1.0},
+    {"powertrain.transmission_temp", 0.5},
+    {"powertrain.throttle_position", 1.0},
+    {"chassis.brake_pressure", 0.5},
+    {"chassis.steering_angle", 0.5},
+    {"chassis.suspension_height", 1.0},
+    {"chassis.wheel_speed", 0.5},
+    {"chassis.brake_pad_wear", 0.5},
+    {"battery.voltage", 0.05},
+    {"battery.current", 0.5},
+    {"battery.temperature", 0.5},
+    {"battery.state_of_charge", 0.5},
+    {"battery.power_consumption", 10.0},
+    {"adas.forward_collision_distance", 0.5},
+    {"adas.lane_deviation", 0.05},
+    {"adas.obstacle_distances", 0.5},
+    {"adas.adaptive_cruise_speed", 0.5},
+    {"adas.time_to_collision", 0.1},
+};
+
+struct PublisherOptions {
+    bool use_zero_copy;
+    TransportOptions transport;
+    TopicRates rates;
+    bool on_change;                       // write only changed samples (plus heartbeats)
+    std::chrono::milliseconds heartbeat;  // longest interval without a write in on_change mode
+    DeadBands dead_bands;
+    int32_t reader_filters;               // filtered readers a writer evaluates filters for, 0 = none
+    std::map<std::string, uint32_t> deadlines_ms;  // offered DEADLINE by topic, 0 = none
+
+    PublisherOptions()
+        : use_zero_copy(false)
+        , on_change(false)
+        , heartbeat(1000)
+        , reader_filters(32) {
+        for (const auto& entry : kDefaultDeadBands) {
+            dead_bands.set(entry.field, entry.band);
+        }
+        // Five periods at the default rates of the safety-relevant topics, so
+        // readers can request a deadline and notice a stalled publisher
+        deadlines_ms["chassis"] = 50;
+        deadlines_ms["adas"] = 250;
+    }
+};
+
 class VehicleSystemsPublisher {
 private:
     // DDS Entities
     DomainParticipant* participant_;
     Publisher* publisher_;
     
-    // Topics and Writers for each system
+    // Counts the periods in which a writer did not write within its offered
+    // deadline, e.g. after 'rate <topic> 0'
+    class DeadlineListener : public DataWriterListener {
+    public:
+        std::atomic<uint64_t> missed;
+
+        DeadlineListener() : missed(0) {}
+
+        void on_offered_deadline_missed(DataWriter*, const OfferedDeadlineMissedStatus& status) override {
+            missed.store(static_cast<uint64_t>(status.total_count), std::memory_order_relaxed);
+        }
+    };
+
+    // Topic and writer of each system. Every system publishes from its own
+    // thread, so each one also has its own random generator.
     struct TopicWriter {
         Topic* topic;
         DataWriter* writer;
         TypeSupport type;
+        std::mt19937 gen;
+        DeadlineListener deadline_listener;
+
+        TopicWriter() : topic(nullptr), writer(nullptr) {}
     };
 
-    std::map<std::string, TopicWriter> topic_writers_;
+    TopicWriter powertrain_;
+    TopicWriter chassis_;
+    TopicWriter battery_;
+    TopicWriter adas_;
     
-    // Data structures
-    PowertrainData powertrain_data_;
-    ChassisData chassis_data_;
-    BatteryData battery_data_;
-    ADASData adas_data_;
+    // Latest sample of each system. set_value() and the random generator
+    // publish new snapshots; the publishing threads write the newest one
+    // without blocking them.
+    SnapshotBuffer<PowertrainData> powertrain_data_;
+    SnapshotBuffer<ChassisData> chassis_data_;
+    SnapshotBuffer<BatteryData> battery_data_;
+    SnapshotBuffer<ADASData> adas_data_;
 
     // Thread control
     std::atomic<bool> is_running_;
-    std::mutex mtx_;
-    bool use_random_values_;
+    std::atomic<bool> use_random_values_;
+
+    // Zero-copy mode: ChassisData/BatteryData are plain types, so their writers
+    // use data-sharing and loaned samples instead of CDR serialization
+    bool use_zero_copy_;
+    TransportOptions transport_;
 
-    // Random generators
+    // Publishes every topic at its own fixed rate
+    TopicRates rates_;
+    PeriodicScheduler scheduler_;
+
+    // Seeds the per-system generators
     std::random_device rd_;
-    std::mt19937 gen_;
+
+    // Change-only mode: samples that moved less than their dead-bands are not
+    // written, except for a heartbeat. Discrete fields (gear, status, flags,
+    // codes) count on any change; timestamps are ignored.
+    std::unique_ptr<ChangeFilter<PowertrainData>> powertrain_filter_;
+    std::unique_ptr<ChangeFilter<ChassisData>> chassis_filter_;
+    std::unique_ptr<ChangeFilter<BatteryData>> battery_filter_;
+    std::unique_ptr<ChangeFilter<ADASData>> adas_filter_;
+
+    // Writer-side content filtering: the writers evaluate the filters of up to
+    // reader_filters_ matched filtered readers and do not send them the
+    // samples that fail. Data-sharing readers filter on their side.
+    VehicleFilterFactory filter_factory_;
+    int32_t reader_filters_;
+
+    // Offered deadline of each topic's writer
+    std::map<std::string, uint32_t> deadlines_ms_;
+
+    uint32_t deadline_ms(const std::string& topic_name) const {
+        auto it = deadlines_ms_.find(topic_name);
+        return it != deadlines_ms_.end() ? it->second : 0;
+    }
+
+    template<size_t N>
+    static bool array_exceeds(const std::array<float, N>& previous, const std::array<float, N>& current,
+                              double band) {
+        for (size_t i = 0; i < N; ++i) {
+            if (DeadBands::exceeds(previous[i], current[i], band)) return true;
+        }
+        return false;
+    }
+
+    // A steady value is only written by the heartbeat, so a topic with an
+    // offered deadline gets a heartbeat of at most half of it (the margin
+    // covers the publish period the filter is evaluated at). Without it the
+    // writer would miss its deadline whenever the values hold still.
+    std::chrono::steady_clock::duration heartbeat_for(const std::string& topic_name,
+                                                      std::chrono::milliseconds heartbeat) const {
+        uint32_t deadline = deadline_ms(topic_name);
+        if (deadline == 0) return heartbeat;
+        std::chrono::milliseconds limit(std::max<uint32_t>(1, deadline / 2));
+        return heartbeat.count() == 0 || heartbeat > limit ? limit : heartbeat;
+    }
+
+    void create_change_filters(const PublisherOptions& options) {
+        const DeadBands& bands = options.dead_bands;
+
+        double rpm = bands.get("powertrain.engine_rpm");
+        double engine_temp = bands.get("powertrain.engine_temperature");
+        double load = bands.get("powertrain.engine_load");
+        double trans_temp = bands.get("powertrain.transmission_temp");
+        double throttle = bands.get("powertrain.throttle_position");
+        powertrain_filter_.reset(new ChangeFilter<PowertrainData>(
+            [=](const PowertrainData& a, const PowertrainData& b) {
+                return a.current_gear() != b.current_gear() || a.dtc_codes() != b.dtc_codes() ||
+                       DeadBands::exceeds(a.engine_rpm(), b.engine_rpm(), rpm) ||
+                       DeadBands::exceeds(a.engine_temperature(), b.engine_temperature(), engine_temp) ||
+                       DeadBands::exceeds(a.engine_load(), b.engine_load(), load) ||
+                       DeadBands::exceeds(a.transmission_temp(), b.transmission_temp(), trans_temp) ||
+                       DeadBands::exceeds(a.throttle_position(), b.throttle_position(), throttle);
+            }, heartbeat_for("powertrain", options.heartbeat)));
+
+        double brake = bands.get("chassis.brake_pressure");
+        double steering = bands.get("chassis.steering_angle");
+        double suspension = bands.get("chassis.suspension_height");
+        double wheel = bands.get("chassis.wheel_speed");
+        double pad_wear = bands.get("chassis.brake_pad_wear");
+        chassis_filter_.reset(new ChangeFilter<ChassisData>(
+            [=](const ChassisData& a, const ChassisData& b) {
+                return a.abs_active() != b.abs_active() ||
+                       a.traction_control_active() != b.traction_control_active() ||
+                       DeadBands::exceeds(a.brake_pressure(), b.brake_pressure(), brake) ||
+                       DeadBands::exceeds(a.steering_angle(), b.steering_angle(), steering) ||
+                       array_exceeds(a.suspension_height(), b.suspension_height(), suspension) ||
+                       array_exceeds(a.wheel_speed(), b.wheel_speed(), wheel) ||
+                       array_exceeds(a.brake_pad_wear(), b.brake_pad_wear(), pad_wear);
+            }, heartbeat_for("chassis", options.heartbeat)));
+
+        double voltage = bands.get("battery.voltage");
+        double current = bands.get("battery.current");
+        double battery_temp = bands.get("battery.temperature");
+        double soc = bands.get("battery.state_of_charge");
+        double power = bands.get("battery.power_consumption");
+        battery_filter_.reset(new ChangeFilter<BatteryData>(
+            [=](const BatteryData& a, const BatteryData& b) {
+                return a.charging_cycles() != b.charging_cycles() ||
+                       a.charging_status() != b.charging_status() ||
+                       DeadBands::exceeds(a.voltage(), b.voltage(), voltage) ||
+                       DeadBands::exceeds(a.current(), b.current(), current) ||
+                       DeadBands::exceeds(a.temperature(), b.temperature(), battery_temp) ||
+                       DeadBands::exceeds(a.state_of_charge(), b.state_of_charge(), soc) ||
+                       DeadBands::exceeds(a.power_consumption(), b.power_consumption(), power);
+            }, heartbeat_for("battery", options.heartbeat)));
+
+        double distance = bands.get("adas.forward_collision_distance");
+        double deviation = bands.get("adas.lane_deviation");
+        double obstacle = bands.get("adas.obstacle_distances");
+        double cruise = bands.get("adas.adaptive_cruise_speed");
+        double ttc = bands.get("adas.time_to_collision");
+        adas_filter_.reset(new ChangeFilter<ADASData>(
+            [=](const ADASData& a, const ADASData& b) {
+                if (a.lane_departure_warning() != b.lane_departure_warning() ||
+                    a.forward_collision_warning() != b.forward_collision_warning() ||
+                    a.blind_spot_warning_left() != b.blind_spot_warning_left() ||
+                    a.blind_spot_warning_right() != b.blind_spot_warning_right() ||
+                    a.obstacle_distances().size() != b.obstacle_distances().size()) {
+                    return true;
+                }
+                for (size_t i = 0; i < a.obstacle_distances().size(); ++i) {
+                    if (DeadBands::exceeds(a.obstacle_distances()[i], b.obstacle_distances()[i], obstacle)) {
+                        return true;
+                    }
+                }
+                return DeadBands::exceeds(a.forward_collision_distance(), b.forward_collision_distance(), distance) ||
+                       DeadBands::exceeds(a.lane_deviation(), b.lane_deviation(), deviation) ||
+                       DeadBands::exceeds(a.adaptive_cruise_speed(), b.adaptive_cruise_speed(), cruise) ||
+                       DeadBands::exceeds(a.time_to_collision(), b.time_to_collision(), ttc);
+            }, heartbeat_for("adas", options.heartbeat)));
+    }
+
+    template<typename T>
+    static void print_filter_stats(const char* name, const ChangeFilter<T>& filter) {
+        uint64_t sent = filter.sent();
+        uint64_t total = sent + filter.suppressed();
+        std::cout << "  " << name << ": sent " << sent << " of " << total
+                  << " (" << (total > 0 ? 100.0 * filter.suppressed() / total : 0.0) << "% suppressed, "
+                  << filter.heartbeats() << " heartbeats every "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(filter.heartbeat()).count() << " ms)\n";
+    }
+
+    void print_deadline_stats(const char* name, const TopicWriter& topic_writer) const {
+        uint32_t deadline = deadline_ms(name);
+        if (deadline == 0) return;
+        std::cout << "  " << name << ": " << deadline << " ms, missed "
+                  << topic_writer.deadline_listener.missed.load(std::memory_order_relaxed) << " times\n";
+    }
+
+    // Evaluations count once per sample and filtered reader
+    void print_content_filter_stats(const char* name, const char* type_name) const {
+        const VehicleFilterCounters* counters = filter_factory_.counters(type_name);
+        uint64_t evaluated = counters->evaluated.load(std::memory_order_relaxed);
+        uint64_t passed = counters->passed.load(std::memory_order_relaxed);
+        uint64_t saved_bytes = counters->evaluated_bytes.load(std::memory_order_relaxed) -
+                               counters->passed_bytes.load(std::memory_order_relaxed);
+        std::cout << "  " << name << ": sent " << passed << " of " << evaluated
+                  << " samples to filtered readers, " << saved_bytes << " payload bytes not sent\n";
+    }
 
 public:
-    VehicleSystemsPublisher() 
+    explicit VehicleSystemsPublisher(const PublisherOptions& options = PublisherOptions())
         : participant_(nullptr)
         , publisher_(nullptr)
         , is_running_(true)
         , use_random_values_(true)
-        , gen_(rd_()) {
+        , use_zero_copy_(options.use_zero_copy)
+        , transport_(options.transport)
+        , rates_(options.rates)
+        , reader_filters_(options.reader_filters)
+        , deadlines_ms_(options.deadlines_ms) {
+        if (options.on_change) {
+            create_change_filters(options);
+        }
+        powertrain_.gen.seed(rd_());
+        chassis_.gen.seed(rd_());
+        battery_.gen.seed(rd_());
+        adas_.gen.seed(rd_());
+    }
+
+    DataWriterQos writer_qos(const std::string& topic_name) const {
+        DataWriterQos qos = DATAWRITER_QOS_DEFAULT;
+        qos.writer_resource_limits().reader_filters_allocation.initial = 0;
+        qos.writer_resource_limits().reader_filters_allocation.maximum = static_cast<size_t>(reader_filters_);
+        uint32_t deadline = deadline_ms(topic_name);
+        if (deadline > 0) {
+            qos.deadline().period = eprosima::fastrtps::Duration_t(static_cast<int32_t>(deadline / 1000),
+                                                                   (deadline % 1000) * 1000000u);
+        }
+        return qos;
+    }
+
+    // DataWriter QoS for the plain topics (chassis, battery)
+    DataWriterQos plain_writer_qos(const std::string& topic_name) const {
+        DataWriterQos qos = writer_qos(topic_name);
+        if (use_zero_copy_) {
+            qos.data_sharing().automatic();
+            qos.history().kind = KEEP_LAST_HISTORY_QOS;
+            qos.history().depth = 10;
+            qos.endpoint().history_memory_policy = eprosima::fastrtps::rtps::PREALLOCATED_MEMORY_MODE;
+        }
+        return qos;
+    }
+
+    // Writes a plain sample through a loaned buffer, falling back to a regular write
+    template<typename T>
+    void write_plain(DataWriter* writer, const T& data) {
+        if (use_zero_copy_) {
+            void* sample = nullptr;
+            if (writer->loan_sample(sample) == ReturnCode_t::RETCODE_OK) {
+                *static_cast<T*>(sample) = data;
+                if (!writer->write(sample)) {
+                    writer->discard_loan(sample);
+                }
+                return;
+            }
+        }
+        writer->write(const_cast<T*>(&data));
     }
 
     bool init() {
         // Create participant
         DomainParticipantQos participantQos;
         participantQos.name("VehicleSystems_Publisher");
+        apply_transport(participantQos, transport_);
         participant_ = DomainParticipantFactory::get_instance()->create_participant(0, participantQos);
         if (participant_ == nullptr) return false;
 
+        if (participant_->register_content_filter_factory(kVehicleFilterClass, &filter_factory_) !=
+                ReturnCode_t::RETCODE_OK) {
+            return false;
+        }
+
         // Create publisher
         publisher_ = participant_->create_publisher(PUBLISHER_QOS_DEFAULT);
         if (publisher_ == nullptr) return false;
 
         // Initialize Powertrain topic and writer
-        TopicWriter powertrain;
-        powertrain.type = TypeSupport(new PowertrainDataPubSubType());
-        powertrain.type.register_type(participant_);
-        powertrain.topic = participant_->create_topic("PowertrainTopic", "PowertrainData", TOPIC_QOS_DEFAULT);
-        powertrain.writer = publisher_->create_datawriter(powertrain.topic, DATAWRITER_QOS_DEFAULT);
-        topic_writers_["powertrain"] = powertrain;
+        powertrain_.type = TypeSupport(new PowertrainDataPubSubType());
+        powertrain_.type.register_type(participant_);
+        powertrain_.topic = participant_->create_topic("PowertrainTopic", "PowertrainData", TOPIC_QOS_DEFAULT);
+        powertrain_.writer = publisher_->create_datawriter(powertrain_.topic, writer_qos("powertrain"), &powertrain_.deadline_listener);
 
         // Initialize Chassis topic and writer
-        TopicWriter chassis;
-        chassis.type = TypeSupport(new ChassisDataPubSubType());
-        chassis.type.register_type(participant_);
-        chassis.topic = participant_->create_topic("ChassisTopic", "ChassisData", TOPIC_QOS_DEFAULT);
-        chassis.writer = publisher_->create_datawriter(chassis.topic, DATAWRITER_QOS_DEFAULT);
-        topic_writers_["chassis"] = chassis;
+        chassis_.type = TypeSupport(new ChassisDataPubSubType());
+        chassis_.type.register_type(participant_);
+        chassis_.topic = participant_->create_topic("ChassisTopic", "ChassisData", TOPIC_QOS_DEFAULT);
+        chassis_.writer = publisher_->create_datawriter(chassis_.topic, plain_writer_qos("chassis"), &chassis_.deadline_listener);
 
         // Initialize Battery topic and writer
-        TopicWriter battery;
-        battery.type = TypeSupport(new BatteryDataPubSubType());
-        battery.type.register_type(participant_);
-        battery.topic = participant_->create_topic("BatteryTopic", "BatteryData", TOPIC_QOS_DEFAULT);
-        battery.writer = publisher_->create_datawriter(battery.topic, DATAWRITER_QOS_DEFAULT);
-        topic_writers_["battery"] = battery;
+        battery_.type = TypeSupport(new BatteryDataPubSubType());
+        battery_.type.register_type(participant_);
+        battery_.topic = participant_->create_topic("BatteryTopic", "BatteryData", TOPIC_QOS_DEFAULT);
+        battery_.writer = publisher_->create_datawriter(battery_.topic, plain_writer_qos("battery"), &battery_.deadline_listener);
 
         // Initialize ADAS topic and writer
-        TopicWriter adas;
-        adas.type = TypeSupport(new ADASDataPubSubType());
-        adas.type.register_type(participant_);
-        adas.topic = participant_->create_topic("ADASTopic", "ADASData", TOPIC_QOS_DEFAULT);
-        adas.writer = publisher_->create_datawriter(adas.topic, DATAWRITER_QOS_DEFAULT);
-        topic_writers_["adas"] = adas;
+        adas_.type = TypeSupport(new ADASDataPubSubType());
+        adas_.type.register_type(participant_);
+        adas_.topic = participant_->create_topic("ADASTopic", "ADASData", TOPIC_QOS_DEFAULT);
+        adas_.writer = publisher_->create_datawriter(adas_.topic, writer_qos("adas"), &adas_.deadline_listener);
 
         return true;
     }
 
-    void update_random_values() {
-    std::lock_guard<std::mutex> lock(mtx_);
-    
-    // Update Powertrain data
-    powertrain_data_.timestamp(std::chrono::system_clock::now().time_since_epoch().count());
-    powertrain_data_.engine_rpm(std::uniform_real_distribution<>(800.0, 3000.0)(gen_));
-    powertrain_data_.engine_temperature(std::uniform_real_distribution<>(75.0, 95.0)(gen_));
-    powertrain_data_.engine_load(std::uniform_real_distribution<>(0.0, 100.0)(gen_));
-    powertrain_data_.transmission_temp(std::uniform_real_distribution<>(70.0, 90.0)(gen_));
-    powertrain_data_.current_gear(std::uniform_int_distribution<>(1, 6)(gen_));
-    powertrain_data_.throttle_position(std::uniform_real_distribution<>(0.0, 100.0)(gen_));
-    // Random DTC codes
-    if (std::uniform_real_distribution<>(0.0, 1.0)(gen_) < 0.1) {
-        std::vector<std::string> codes = {"P0301", "P0302", "P0303"};
-        powertrain_data_.dtc_codes(codes);
+    void update_powertrain_values() {
+        powertrain_data_.update([this](PowertrainData& data) {
+            data.engine_rpm(std::uniform_real_distribution<>(800.0, 3000.0)(powertrain_.gen));
+            data.engine_temperature(std::uniform_real_distribution<>(75.0, 95.0)(powertrain_.gen));
+            data.engine_load(std::uniform_real_distribution<>(0.0, 100.0)(powertrain_.gen));
+            data.transmission_temp(std::uniform_real_distribution<>(70.0, 90.0)(powertrain_.gen));
+            data.current_gear(std::uniform_int_distribution<>(1, 6)(powertrain_.gen));
+            data.throttle_position(std::uniform_real_distribution<>(0.0, 100.0)(powertrain_.gen));
+            // Random DTC codes
+            if (std::uniform_real_distribution<>(0.0, 1.0)(powertrain_.gen) < 0.1) {
+                std::vector<eprosima::fastcdr::fixed_string<8>> codes = {"P0301", "P0302", "P0303"};
+                data.dtc_codes(codes);
+            }
+        });
+    }
+
+    void update_chassis_values() {
+        chassis_data_.update([this](ChassisData& data) {
+            data.brake_pressure(std::uniform_real_distribution<>(0.0, 100.0)(chassis_.gen));
+            data.steering_angle(std::uniform_real_distribution<>(-30.0, 30.0)(chassis_.gen));
+            // Update arrays
+            for (int i = 0; i < 4; i++) {
+                data.suspension_height()[i] = std::uniform_real_distribution<>(150.0, 200.0)(chassis_.gen);
+                data.wheel_speed()[i] = std::uniform_real_distribution<>(0.0, 120.0)(chassis_.gen);
+                data.brake_pad_wear()[i] = std::uniform_real_distribution<>(0.0, 100.0)(chassis_.gen);
+            }
+            data.abs_active(std::uniform_real_distribution<>(0.0, 1.0)(chassis_.gen) < 0.1);
+            data.traction_control_active(std::uniform_real_distribution<>(0.0, 1.0)(chassis_.gen) < 0.1);
+        });
     }
 
-    // Update Chassis data
-    chassis_data_.timestamp(std::chrono::system_clock::now().time_since_epoch().count());
-    chassis_data_.brake_pressure(std::uniform_real_distribution<>(0.0, 100.0)(gen_));
-    chassis_data_.steering_angle(std::uniform_real_distribution<>(-30.0, 30.0)(gen_));
-    // Update arrays
-    for (int i = 0; i < 4; i++) {
-        chassis_data_.suspension_height()[i] = std::uniform_real_distribution<>(150.0, 200.0)(gen_);
-        chassis_data_.wheel_speed()[i] = std::uniform_real_distribution<>(0.0, 120.0)(gen_);
-        chassis_data_.brake_pad_wear()[i] = std::uniform_real_distribution<>(0.0, 100.0)(gen_);
+    void update_battery_values() {
+        battery_data_.update([this](BatteryData& data) {
+            data.voltage(std::uniform_real_distribution<>(11.0, 14.4)(battery_.gen));
+            data.current(std::uniform_real_distribution<>(-20.0, 100.0)(battery_.gen));
+            data.temperature(std::uniform_real_distribution<>(20.0, 40.0)(battery_.gen));
+            data.state_of_charge(std::uniform_real_distribution<>(0.0, 100.0)(battery_.gen));
+            data.power_consumption(std::uniform_real_distribution<>(0.0, 3000.0)(battery_.gen));
+            data.charging_cycles(std::uniform_int_distribution<>(0, 1000)(battery_.gen));
+            data.charging_status(std::uniform_real_distribution<>(0.0, 1.0)(battery_.gen) < 0.2);
+        });
     }
-    chassis_data_.abs_active(std::uniform_real_distribution<>(0.0, 1.0)(gen_) < 0.1);
-    chassis_data_.traction_control_active(std::uniform_real_distribution<>(0.0, 1.0)(gen_) < 0.1);
-
-    // Update Battery data
-    battery_data_.timestamp(std::chrono::system_clock::now().time_since_epoch().count());
-    battery_data_.voltage(std::uniform_real_distribution<>(11.0, 14.4)(gen_));
-    battery_data_.current(std::uniform_real_distribution<>(-20.0, 100.0)(gen_));
-    battery_data_.temperature(std::uniform_real_distribution<>(20.0, 40.0)(gen_));
-    battery_data_.state_of_charge(std::uniform_real_distribution<>(0.0, 100.0)(gen_));
-    battery_data_.power_consumption(std::uniform_real_distribution<>(0.0, 3000.0)(gen_));
-    battery_data_.charging_cycles(std::uniform_int_distribution<>(0, 1000)(gen_));
-    battery_data_.charging_status(std::uniform_real_distribution<>(0.0, 1.0)(gen_) < 0.2);
-
-    // Update ADAS data
-    adas_data_.timestamp(std::chrono::system_clock::now().time_since_epoch().count());
-    adas_data_.forward_collision_distance(std::uniform_real_distribution<>(0.0, 100.0)(gen_));
-    adas_data_.lane_deviation(std::uniform_real_distribution<>(-1.0, 1.0)(gen_));
-    adas_data_.lane_departure_warning(std::uniform_real_distribution<>(0.0, 1.0)(gen_) < 0.1);
-    adas_data_.forward_collision_warning(std::uniform_real_distribution<>(0.0, 1.0)(gen_) < 0.1);
-    adas_data_.blind_spot_warning_left(std::uniform_real_distribution<>(0.0, 1.0)(gen_) < 0.1);
-    adas_data_.blind_spot_warning_right(std::uniform_real_distribution<>(0.0, 1.0)(gen_) < 0.1);
-    // Update obstacle distances
-    std::vector<float> obstacles;
-    int num_obstacles = std::uniform_int_distribution<>(1, 3)(gen_);
-    for (int i = 0; i < num_obstacles; i++) {
-        obstacles.push_back(std::uniform_real_distribution<>(1.0, 50.0)(gen_));
+
+    void update_adas_values() {
+        adas_data_.update([this](ADASData& data) {
+            data.forward_collision_distance(std::uniform_real_distribution<>(0.0, 100.0)(adas_.gen));
+            data.lane_deviation(std::uniform_real_distribution<>(-1.0, 1.0)(adas_.gen));
+            data.lane_departure_warning(std::uniform_real_distribution<>(0.0, 1.0)(adas_.gen) < 0.1);
+            data.forward_collision_warning(std::uniform_real_distribution<>(0.0, 1.0)(adas_.gen) < 0.1);
+            data.blind_spot_warning_left(std::uniform_real_distribution<>(0.0, 1.0)(adas_.gen) < 0.1);
+            data.blind_spot_warning_right(std::uniform_real_distribution<>(0.0, 1.0)(adas_.gen) < 0.1);
+            // Update obstacle distances
+            std::vector<float> obstacles;
+            int num_obstacles = std::uniform_int_distribution<>(1, 3)(adas_.gen);
+            for (int i = 0; i < num_obstacles; i++) {
+                obstacles.push_back(std::uniform_real_distribution<>(1.0, 50.0)(adas_.gen));
+            }
+            data.obstacle_distances(obstacles);
+            data.adaptive_cruise_speed(std::uniform_real_distribution<>(0.0, 120.0)(adas_.gen));
+            data.time_to_collision(std::uniform_real_distribution<>(0.0, 10.0)(adas_.gen));
+        });
+    }
+
+    static uint64_t now_timestamp() {
+        return std::chrono::system_clock::now().time_since_epoch().count();
+    }
+
+    void publish_powertrain() {
+        PowertrainData& sample = powertrain_data_.acquire();
+        if (powertrain_filter_ && !powertrain_filter_->accept(sample)) return;
+        sample.timestamp(now_timestamp());
+        powertrain_.writer->write(&sample);
+    }
+
+    void publish_chassis() {
+        ChassisData& sample = chassis_data_.acquire();
+        if (chassis_filter_ && !chassis_filter_->accept(sample)) return;
+        sample.timestamp(now_timestamp());
+        write_plain(chassis_.writer, sample);
     }
-    adas_data_.obstacle_distances(obstacles);
-    adas_data_.adaptive_cruise_speed(std::uniform_real_distribution<>(0.0, 120.0)(gen_));
-    adas_data_.time_to_collision(std::uniform_real_distribution<>(0.0, 10.0)(gen_));
-}
 
-    void publish_data() {
-        std::lock_guard<std::mutex> lock(mtx_);
-        
-        topic_writers_["powertrain"].writer->write(&powertrain_data_);
-        topic_writers_["chassis"].writer->write(&chassis_data_);
-        topic_writers_["battery"].writer->write(&battery_data_);
-        topic_writers_["adas"].writer->write(&adas_data_);
+    void publish_battery() {
+        BatteryData& sample = battery_data_.acquire();
+        if (battery_filter_ && !battery_filter_->accept(sample)) return;
+        sample.timestamp(now_timestamp());
+        write_plain(battery_.writer, sample);
+    }
+
+    void publish_adas() {
+        ADASData& sample = adas_data_.acquire();
+        if (adas_filter_ && !adas_filter_->accept(sample)) return;
+        sample.timestamp(now_timestamp());
+        adas_.writer->write(&sample);
     }
 
     void run() {
+        scheduler_.add_task("powertrain", rates_.powertrain, [this]() {
+            if (use_random_values_) update_powertrain_values();
+            publish_powertrain();
+        });
+        scheduler_.add_task("chassis", rates_.chassis, [this]() {
+            if (use_random_values_) update_chassis_values();
+            publish_chassis();
+        });
+        scheduler_.add_task("battery", rates_.battery, [this]() {
+            if (use_random_values_) update_battery_values();
+            publish_battery();
+        });
+        scheduler_.add_task("adas", rates_.adas, [this]() {
+            if (use_random_values_) update_adas_values();
+            publish_adas();
+        });
+
+        // One publishing thread per system, so a slow ADAS write never
+        // delays the chassis samples
         std::thread publish_thread([this]() {
-            while (is_running_) {
-                if (use_random_values_) {
-                    update_random_values();
-                }
-                publish_data();
-                std::this_thread::sleep_for(std::chrono::milliseconds(4000));  // 10Hz update rate
-            }
+            scheduler_.run_threaded(is_running_);
         });
 
         handle_user_input();
@@ -224,6 +571,8 @@ public:
           << "  adas cruise_speed <value> : Set adaptive cruise speed\n"
           << "  adas collision_time <value> : Set time to collision\n"
           << "\nOther commands:\n"
+          << "  rate <topic> <hz> : Set publish rate of a topic (0 pauses it)\n"
+          << "  stats : Show publish rate, overrun, jitter, change-only and content filter statistics\n"
           << "  random : Enable random mode\n"
           << "  manual : Disable random mode\n"
           << "  quit : Exit program\n"
@@ -241,6 +590,38 @@ public:
             } else if (system == "manual") {
                 use_random_values_ = false;
                 std::cout << "Manual mode enabled\n";
+            } else if (system == "stats") {
+                scheduler_.print_stats(std::cout);
+                if (powertrain_filter_) {
+                    std::cout << "Change-only publishing:\n";
+                    print_filter_stats("powertrain", *powertrain_filter_);
+                    print_filter_stats("chassis", *chassis_filter_);
+                    print_filter_stats("battery", *battery_filter_);
+                    print_filter_stats("adas", *adas_filter_);
+                }
+                if (!deadlines_ms_.empty()) {
+                    std::cout << "Offered deadlines:\n";
+                    print_deadline_stats("powertrain", powertrain_);
+                    print_deadline_stats("chassis", chassis_);
+                    print_deadline_stats("battery", battery_);
+                    print_deadline_stats("adas", adas_);
+                }
+                if (reader_filters_ > 0) {
+                    std::cout << "Writer-side content filters:\n";
+                    print_content_filter_stats("powertrain", "PowertrainData");
+                    print_content_filter_stats("chassis", "ChassisData");
+                    print_content_filter_stats("battery", "BatteryData");
+                    print_content_filter_stats("adas", "ADASData");
+                }
+            } else if (system == "rate") {
+                std::cin >> param;
+                double rate;
+                std::cin >> rate;
+                if (scheduler_.set_rate(param, rate)) {
+                    std::cout << param << " rate set to " << rate << " Hz\n";
+                } else {
+                    std::cout << "Unknown topic: " << param << "\n";
+                }
             } else {
                 std::cin >> param;
                 float value;
@@ -251,54 +632,112 @@ public:
     }
 
     void set_value(const std::string& system, const std::string& param, float value) {
-    std::lock_guard<std::mutex> lock(mtx_);
-    
     if (system == "powertrain") {
-        if (param == "rpm") powertrain_data_.engine_rpm(value);
-        else if (param == "temp") powertrain_data_.engine_temperature(value);
-        else if (param == "load") powertrain_data_.engine_load(value);
-        else if (param == "trans_temp") powertrain_data_.transmission_temp(value);
-        else if (param == "gear") powertrain_data_.current_gear(static_cast<long>(value));
-        else if (param == "throttle") powertrain_data_.throttle_position(value);
+        powertrain_data_.update([&](PowertrainData& data) {
+            if (param == "rpm") data.engine_rpm(value);
+            else if (param == "temp") data.engine_temperature(value);
+            else if (param == "load") data.engine_load(value);
+            else if (param == "trans_temp") data.transmission_temp(value);
+            else if (param == "gear") data.current_gear(static_cast<long>(value));
+            else if (param == "throttle") data.throttle_position(value);
+        });
     }
     else if (system == "chassis") {
-        if (param == "brake") chassis_data_.brake_pressure(value);
-        else if (param == "steering") chassis_data_.steering_angle(value);
-        else if (param == "susp_fl") chassis_data_.suspension_height()[0] = value;
-        else if (param == "susp_fr") chassis_data_.suspension_height()[1] = value;
-        else if (param == "susp_rl") chassis_data_.suspension_height()[2] = value;
-        else if (param == "susp_rr") chassis_data_.suspension_height()[3] = value;
-        else if (param == "wheel_fl") chassis_data_.wheel_speed()[0] = value;
-        else if (param == "wheel_fr") chassis_data_.wheel_speed()[1] = value;
-        else if (param == "wheel_rl") chassis_data_.wheel_speed()[2] = value;
-        else if (param == "wheel_rr") chassis_data_.wheel_speed()[3] = value;
-        else if (param == "abs") chassis_data_.abs_active(value > 0);
-        else if (param == "traction") chassis_data_.traction_control_active(value > 0);
+        chassis_data_.update([&](ChassisData& data) {
+            if (param == "brake") data.brake_pressure(value);
+            else if (param == "steering") data.steering_angle(value);
+            else if (param == "susp_fl") data.suspension_height()[0] = value;
+            else if (param == "susp_fr") data.suspension_height()[1] = value;
+            else if (param == "susp_rl") data.suspension_height()[2] = value;
+            else if (param == "susp_rr") data.suspension_height()[3] = value;
+            else if (param == "wheel_fl") data.wheel_speed()[0] = value;
+            else if (param == "wheel_fr") data.wheel_speed()[1] = value;
+            else if (param == "wheel_rl") data.wheel_speed()[2] = value;
+            else if (param == "wheel_rr") data.wheel_speed()[3] = value;
+            else if (param == "abs") data.abs_active(value > 0);
+            else if (param == "traction") data.traction_control_active(value > 0);
+        });
     }
     else if (system == "battery") {
-        if (param == "voltage") battery_data_.voltage(value);
-        else if (param == "current") battery_data_.current(value);
-        else if (param == "temp") battery_data_.temperature(value);
-        else if (param == "charge") battery_data_.state_of_charge(value);
-        else if (param == "power") battery_data_.power_consumption(value);
-        else if (param == "cycles") battery_data_.charging_cycles(static_cast<long>(value));
-        else if (param == "charging") battery_data_.charging_status(value > 0);
+        battery_data_.update([&](BatteryData& data) {
+            if (param == "voltage") data.voltage(value);
+            else if (param == "current") data.current(value);
+            else if (param == "temp") data.temperature(value);
+            else if (param == "charge") data.state_of_charge(value);
+            else if (param == "power") data.power_consumption(value);
+            else if (param == "cycles") data.charging_cycles(static_cast<long>(value));
+            else if (param == "charging") data.charging_status(value > 0);
+        });
     }
     else if (system == "adas") {
-        if (param == "distance") adas_data_.forward_collision_distance(value);
-        else if (param == "deviation") adas_data_.lane_deviation(value);
-        else if (param == "lane_warning") adas_data_.lane_departure_warning(value > 0);
-        else if (param == "collision_warning") adas_data_.forward_collision_warning(value > 0);
-        else if (param == "blind_left") adas_data_.blind_spot_warning_left(value > 0);
-        else if (param == "blind_right") adas_data_.blind_spot_warning_right(value > 0);
-        else if (param == "cruise_speed") adas_data_.adaptive_cruise_speed(value);
-        else if (param == "collision_time") adas_data_.time_to_collision(value);
+        adas_data_.update([&](ADASData& data) {
+            if (param == "distance") data.forward_collision_distance(value);
+            else if (param == "deviation") data.lane_deviation(value);
+            else if (param == "lane_warning") data.lane_departure_warning(value > 0);
+            else if (param == "collision_warning") data.forward_collision_warning(value > 0);
+            else if (param == "blind_left") data.blind_spot_warning_left(value > 0);
+            else if (param == "blind_right") data.blind_spot_warning_right(value > 0);
+            else if (param == "cruise_speed") data.adaptive_cruise_speed(value);
+            else if (param == "collision_time") data.time_to_collision(value);
+        });
     }
 }
 };
 
-int main() {
-    VehicleSystemsPublisher* publisher = new VehicleSystemsPublisher();
+int main(int argc, char** argv) {
+    PublisherOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--zero-copy") {
+            options.use_zero_copy = true;
+        } else if (arg == "--rate" && i + 1 < argc) {
+            // --rate <topic>=<hz>
+            std::string value = argv[++i];
+            size_t sep = value.find('=');
+            if (sep == std::string::npos ||
+                !options.rates.set(value.substr(0, sep), std::atof(value.c_str() + sep + 1))) {
+                std::cout << "Invalid rate: " << value << "\n";
+                return 1;
+            }
+        } else if (arg == "--on-change") {
+            options.on_change = true;
+        } else if (arg == "--heartbeat" && i + 1 < argc) {
+            options.heartbeat = std::chrono::milliseconds(std::atol(argv[++i]));
+        } else if (arg == "--deadband" && i + 1 < argc) {
+            // --deadband <topic>.<field>=<band>
+            std::string value = argv[++i];
+            if (!options.dead_bands.parse(value)) {
+                std::cout << "Invalid dead-band: " << value << "\n";
+                return 1;
+            }
+        } else if (arg == "--deadline" && i + 1 < argc) {
+            // --deadline <topic>=<ms>
+            std::string value = argv[++i];
+            size_t sep = value.find('=');
+            std::string topic = sep == std::string::npos ? std::string() : value.substr(0, sep);
+            if (topic != "powertrain" && topic != "chassis" && topic != "battery" && topic != "adas") {
+                std::cout << "Invalid deadline: " << value << "\n";
+                return 1;
+            }
+            options.deadlines_ms[topic] = static_cast<uint32_t>(std::strtoul(value.c_str() + sep + 1, nullptr, 10));
+        } else if (arg == "--reader-filters" && i + 1 < argc) {
+            options.reader_filters = std::max(0, std::atoi(argv[++i]));
+        } else if (!parse_transport_arg(argc, argv, i, options.transport)) {
+            std::cout << "Usage: " << argv[0] << " [options]\n"
+                      << "  --zero-copy : Publish chassis/battery via loaned samples and data-sharing\n"
+                      << "  --rate <topic>=<hz> : Publish rate of powertrain/chassis/battery/adas\n"
+                      << "  --on-change : Write a sample only if it changed past its dead-bands\n"
+                      << "  --heartbeat <ms> : Longest interval without a write in --on-change mode (default 1000, 0 = none);\n"
+                      << "                     a topic with an offered deadline uses at most half the deadline\n"
+                      << "  --deadband <topic>.<field>=<band> : Dead-band of a float field, e.g. battery.voltage=0.1\n"
+                      << "  --deadline <topic>=<ms> : Offered deadline of a topic's writer (default chassis=50, adas=250, 0 = none)\n"
+                      << "  --reader-filters <n> : Evaluate the content filters of up to n readers per writer (default 32, 0 = readers filter)\n"
+                      << transport_usage();
+            return 1;
+        }
+    }
+
+    VehicleSystemsPublisher* publisher = new VehicleSystemsPublisher(options);
     if (publisher->init()) {
         publisher->run();
     }
@@ -1,174 +1,708 @@
 #include "VehicleSystems.h"
 #include "VehicleSystemsPubSubTypes.h"
+#include "VehicleSystemsFilter.hpp"
+#include "TransportConfig.hpp"
+#include "RenderQueue.hpp"
+#include "TerminalFrame.hpp"
+#include "BatchTake.hpp"
+#include "AllocationCounter.hpp"
 
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
 #include <fastdds/dds/domain/DomainParticipant.hpp>
 #include <fastdds/dds/topic/TypeSupport.hpp>
+#include <fastdds/dds/topic/ContentFilteredTopic.hpp>
 #include <fastdds/dds/subscriber/Subscriber.hpp>
 #include <fastdds/dds/subscriber/DataReader.hpp>
 #include <fastdds/dds/subscriber/DataReaderListener.hpp>
 #include <fastdds/dds/subscriber/qos/DataReaderQos.hpp>
 #include <fastdds/dds/subscriber/SampleInfo.hpp>
+#include <fastdds/dds/core/LoanableSequence.hpp>
+#include <fastdds/dds/core/condition/WaitSet.hpp>
+#include <fastdds/dds/core/condition/GuardCondition.hpp>
+#include <fastdds/dds/core/condition/StatusCondition.hpp>
 
 #include <thread>
 #include <chrono>
 #include <iomanip>
+#include <iostream>
 #include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdlib>
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 using namespace eprosima::fastdds::dds;
 
+// Per-reader TIME_BASED_FILTER and DEADLINE, 0 = off
+struct ReaderTiming {
+    uint32_t min_separation_ms;  // at most one sample per interval, e.g. for a dashboard
+    uint32_t deadline_ms;        // longest expected gap between samples, e.g. for a safety reader
+
+    ReaderTiming() : min_separation_ms(0), deadline_ms(0) {}
+};
+
+struct SubscriberOptions {
+    bool use_zero_copy;
+    TransportOptions transport;
+    double render_fps;  // dashboard redraws per second
+    int waitset_threads;  // 0 = listener mode, otherwise WaitSet event loop threads
+    int pin_cpu;          // first core for the event loop threads, -1 = no pinning
+    int32_t max_batch;    // samples per take() call
+    std::map<std::string, ReaderTiming> timing;  // by topic name
+
+    SubscriberOptions()
+        : use_zero_copy(false)
+        , render_fps(10.0)
+        , waitset_threads(0)
+        , pin_cpu(-1)
+        , max_batch(kDefaultMaxBatch) {}
+};
+
+// Pins the calling thread to one CPU core (Linux only)
+static void pin_current_thread(int cpu) {
+#ifdef __linux__
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+        std::cerr << "Failed to pin thread to CPU " << cpu << std::endl;
+    }
+#else
+    std::cerr << "CPU pinning is not supported on this platform" << std::endl;
+    (void)cpu;
+#endif
+}
+
 class VehicleSystemsSubscriber {
 private:
     // DDS Entities
     DomainParticipant* participant_;
     Subscriber* subscriber_;
 
+    // Base of the topic listeners: minimum separation between delivered samples
+    // and requested deadline monitoring. The minimum separation is requested
+    // as TIME_BASED_FILTER QoS, but Fast DDS 2.x does not apply that policy,
+    // so the listener drops samples whose source timestamp is closer than
+    // min_separation to the last delivered one, before they are copied or
+    // rendered. A missed deadline means no sample arrived within the period:
+    // the publisher stalled, or the link did.
+    class TimedReaderListener : public DataReaderListener {
+    private:
+        std::atomic<int64_t> last_delivered_ns_;  // source timestamp, -1: none yet
+
+        static int64_t steady_ns() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+    public:
+        std::atomic<int64_t> min_separation_ns;
+        std::atomic<uint64_t> separated;          // samples dropped by the minimum separation
+        std::atomic<uint64_t> deadline_missed;    // RequestedDeadlineMissedStatus::total_count
+        std::atomic<int64_t> last_sample_at_ns;   // steady clock
+        std::atomic<int64_t> last_missed_at_ns;   // steady clock
+        std::atomic<uint32_t> incompatible_qos;   // matches refused, e.g. deadline shorter than offered
+        std::atomic<uint32_t> incompatible_policy;
+
+        TimedReaderListener()
+            : last_delivered_ns_(-1)
+            , min_separation_ns(0)
+            , separated(0)
+            , deadline_missed(0)
+            , last_sample_at_ns(0)
+            , last_missed_at_ns(0)
+            , incompatible_qos(0)
+            , incompatible_policy(0) {}
+
+        // Returns false if the sample comes too soon after the last delivered one
+        bool accept(const SampleInfo& info) {
+            last_sample_at_ns.store(steady_ns(), std::memory_order_relaxed);
+            int64_t separation = min_separation_ns.load(std::memory_order_relaxed);
+            if (separation <= 0) return true;
+
+            int64_t timestamp = info.source_timestamp.to_ns();
+            int64_t last = last_delivered_ns_.load(std::memory_order_relaxed);
+            if (last >= 0 && timestamp >= last && timestamp - last < separation) {
+                separated.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            last_delivered_ns_.store(timestamp, std::memory_order_relaxed);
+            return true;
+        }
+
+        // No sample since the last missed deadline
+        bool stalled() const {
+            int64_t missed = last_missed_at_ns.load(std::memory_order_relaxed);
+            return missed != 0 && missed >= last_sample_at_ns.load(std::memory_order_relaxed);
+        }
+
+        void on_requested_deadline_missed(DataReader*, const RequestedDeadlineMissedStatus& status) override {
+            deadline_missed.store(static_cast<uint64_t>(status.total_count), std::memory_order_relaxed);
+            last_missed_at_ns.store(steady_ns(), std::memory_order_relaxed);
+        }
+
+        void on_requested_incompatible_qos(DataReader*, const RequestedIncompatibleQosStatus& status) override {
+            incompatible_qos.store(static_cast<uint32_t>(status.total_count), std::memory_order_relaxed);
+            incompatible_policy.store(static_cast<uint32_t>(status.last_policy_id), std::memory_order_relaxed);
+        }
+    };
+
+    // A filtered subscription reads through a ContentFilteredTopic on top of
+    // the topic; the filter expression is empty otherwise
     struct TopicReader {
         Topic* topic;
+        ContentFilteredTopic* filtered;
+        std::string filter;
         DataReader* reader;
         TypeSupport type;
+        TimedReaderListener* listener;
+
+        TopicReader() : topic(nullptr), filtered(nullptr), reader(nullptr), listener(nullptr) {}
     };
 
     std::map<std::string, TopicReader> topic_readers_;
 
-    // Listeners for each system
-    class PowertrainListener : public DataReaderListener {
+    // Evaluates the content filters of this participant's readers. A publisher
+    // that registers the same filter class evaluates them before sending.
+    VehicleFilterFactory filter_factory_;
+
+    // Listeners for each system. They run on the Fast DDS receive threads and
+    // only queue the samples; printing happens on the render thread.
+    // Samples are copied into queue cells that keep their capacity, so after
+    // warm-up the receive path does not allocate; 'stats' shows the count.
+    class PowertrainListener : public TimedReaderListener {
     public:
+        RenderQueue<PowertrainData> queue;
+        int32_t max_batch = kDefaultMaxBatch;
+        AllocationStats allocations;
+
         void on_data_available(DataReader* reader) override {
-            PowertrainData data;
-            SampleInfo info;
-            while (reader->take_next_sample(&data, &info) == ReturnCode_t::RETCODE_OK) {
-                if (info.valid_data) {
-                    std::cout << "\033[2J\033[H";  // Clear screen
-                    std::cout << "=== Powertrain Data ===\n";
-                    std::cout << "Engine RPM: " << data.engine_rpm() << "\n";
-                    std::cout << "Engine Temperature: " << data.engine_temperature() << "°C\n";
-                    std::cout << "Engine Load: " << data.engine_load() << "%\n";
-                    std::cout << "Transmission Temperature: " << data.transmission_temp() << "°C\n";
-                    std::cout << "Current Gear: " << data.current_gear() << "\n";
-                    if (!data.dtc_codes().empty()) {
-                        std::cout << "DTC Codes:\n";
-                        for (const auto& code : data.dtc_codes()) {
-                            std::cout << "  " << code << "\n";
-                        }
-                    }
-                }
-            }
+            uint64_t before = alloc_counter::thread_allocations();
+            size_t taken = take_batches<PowertrainData>(reader, max_batch, [this](const PowertrainData& data, const SampleInfo& info) {
+                if (accept(info)) queue.push(data);
+            });
+            allocations.add(alloc_counter::thread_allocations() - before, taken);
         }
     } powertrain_listener_;
 
-    class ChassisListener : public DataReaderListener {
+    // ChassisData and BatteryData are plain types: take() loans the samples so
+    // with data-sharing they are read in place from the writer's shared memory
+    class ChassisListener : public TimedReaderListener {
     public:
+        RenderQueue<ChassisData> queue;
+        int32_t max_batch = kDefaultMaxBatch;
+        AllocationStats allocations;
+
         void on_data_available(DataReader* reader) override {
-            ChassisData data;
-            SampleInfo info;
-            while (reader->take_next_sample(&data, &info) == ReturnCode_t::RETCODE_OK) {
-                if (info.valid_data) {
-                    std::cout << "\n=== Chassis Data ===\n";
-                    std::cout << "Brake Pressure: " << data.brake_pressure() << " bar\n";
-                    std::cout << "Steering Angle: " << data.steering_angle() << "°\n";
-                    std::cout << "Suspension Height (FL,FR,RL,RR): ";
-                    for (int i = 0; i < 4; i++) {
-                        std::cout << data.suspension_height()[i] << "mm ";
-                    }
-                    std::cout << "\nWheel Speed (FL,FR,RL,RR): ";
-                    for (int i = 0; i < 4; i++) {
-                        std::cout << data.wheel_speed()[i] << "km/h ";
-                    }
-                    std::cout << "\nABS Active: " << (data.abs_active() ? "YES" : "NO") << "\n";
-                    std::cout << "Traction Control: " << (data.traction_control_active() ? "ON" : "OFF") << "\n";
+            uint64_t before = alloc_counter::thread_allocations();
+            size_t taken = 0;
+            LoanableSequence<ChassisData> samples;
+            SampleInfoSeq infos;
+            while (reader->take(samples, infos, max_batch) == ReturnCode_t::RETCODE_OK) {
+                for (LoanableCollection::size_type i = 0; i < samples.length(); ++i) {
+                    const ChassisData& data = samples[i];
+                    // A data-sharing sample may be overwritten by the writer while loaned
+                    if (!infos[i].valid_data || !reader->is_sample_valid(&data, &infos[i])) continue;
+                    if (accept(infos[i])) queue.push(data);
+                    ++taken;
                 }
+                reader->return_loan(samples, infos);
             }
+            allocations.add(alloc_counter::thread_allocations() - before, taken);
         }
     } chassis_listener_;
 
-    class BatteryListener : public DataReaderListener {
+    class BatteryListener : public TimedReaderListener {
     public:
+        RenderQueue<BatteryData> queue;
+        int32_t max_batch = kDefaultMaxBatch;
+        AllocationStats allocations;
+
         void on_data_available(DataReader* reader) override {
-            BatteryData data;
-            SampleInfo info;
-            while (reader->take_next_sample(&data, &info) == ReturnCode_t::RETCODE_OK) {
-                if (info.valid_data) {
-                    std::cout << "\n=== Battery Data ===\n";
-                    std::cout << "Voltage: " << data.voltage() << "V\n";
-                    std::cout << "Current: " << data.current() << "A\n";
-                    std::cout << "Temperature: " << data.temperature() << "°C\n";
-                    std::cout << "State of Charge: " << data.state_of_charge() << "%\n";
-                    std::cout << "Power Consumption: " << data.power_consumption() << "W\n";
-                    std::cout << "Charging Status: " << (data.charging_status() ? "Charging" : "Not Charging") << "\n";
+            uint64_t before = alloc_counter::thread_allocations();
+            size_t taken = 0;
+            LoanableSequence<BatteryData> samples;
+            SampleInfoSeq infos;
+            while (reader->take(samples, infos, max_batch) == ReturnCode_t::RETCODE_OK) {
+                for (LoanableCollection::size_type i = 0; i < samples.length(); ++i) {
+                    const BatteryData& data = samples[i];
+                    // A data-sharing sample may be overwritten by the writer while loaned
+                    if (!infos[i].valid_data || !reader->is_sample_valid(&data, &infos[i])) continue;
+                    if (accept(infos[i])) queue.push(data);
+                    ++taken;
                 }
+                reader->return_loan(samples, infos);
             }
+            allocations.add(alloc_counter::thread_allocations() - before, taken);
         }
     } battery_listener_;
 
-    class ADASListener : public DataReaderListener {
+    class ADASListener : public TimedReaderListener {
     public:
+        RenderQueue<ADASData> queue;
+        int32_t max_batch = kDefaultMaxBatch;
+        AllocationStats allocations;
+
         void on_data_available(DataReader* reader) override {
-            ADASData data;
-            SampleInfo info;
-            while (reader->take_next_sample(&data, &info) == ReturnCode_t::RETCODE_OK) {
-                if (info.valid_data) {
-                    std::cout << "\n=== ADAS Data ===\n";
-                    std::cout << "Forward Collision Distance: " << data.forward_collision_distance() << "m\n";
-                    std::cout << "Lane Deviation: " << data.lane_deviation() << "m\n";
-                    std::cout << "Lane Departure Warning: " << (data.lane_departure_warning() ? "ACTIVE" : "inactive") << "\n";
-                    std::cout << "Forward Collision Warning: " << (data.forward_collision_warning() ? "ACTIVE" : "inactive") << "\n";
-                    std::cout << "Blind Spot Warning (L/R): " 
-                             << (data.blind_spot_warning_left() ? "LEFT " : "")
-                             << (data.blind_spot_warning_right() ? "RIGHT" : "") << "\n";
-                    std::cout << "Adaptive Cruise Speed: " << data.adaptive_cruise_speed() << "km/h\n";
-                    std::cout << "Time to Collision: " << data.time_to_collision() << "s\n";
-                }
-            }
+            uint64_t before = alloc_counter::thread_allocations();
+            size_t taken = take_batches<ADASData>(reader, max_batch, [this](const ADASData& data, const SampleInfo& info) {
+                if (accept(info)) queue.push(data);
+            });
+            allocations.add(alloc_counter::thread_allocations() - before, taken);
         }
     } adas_listener_;
 
+    // Newest sample of each system, owned by the render thread
+    template<typename T>
+    struct LatestSample {
+        T data;
+        bool valid;
+
+        LatestSample() : valid(false) {}
+
+        // Returns true if at least one new sample was taken from the queue
+        bool drain(RenderQueue<T>& queue) {
+            bool updated = false;
+            while (queue.pop(data)) {
+                updated = true;
+            }
+            valid = valid || updated;
+            return updated;
+        }
+    };
+
+    LatestSample<PowertrainData> powertrain_latest_;
+    LatestSample<ChassisData> chassis_latest_;
+    LatestSample<BatteryData> battery_latest_;
+    LatestSample<ADASData> adas_latest_;
+    std::string stalled_shown_;
+    TerminalFrame frame_;
+    // Declared after everything render_frame() uses, so it is destroyed (and
+    // its thread joined after the final frame) first
+    RenderLoop render_loop_;
+
+    static void print_powertrain(std::ostream& out, const PowertrainData& data) {
+        out << "=== Powertrain Data ===\n";
+        out << "Engine RPM: " << data.engine_rpm() << "\n";
+        out << "Engine Temperature: " << data.engine_temperature() << "°C\n";
+        out << "Engine Load: " << data.engine_load() << "%\n";
+        out << "Transmission Temperature: " << data.transmission_temp() << "°C\n";
+        out << "Current Gear: " << data.current_gear() << "\n";
+        if (!data.dtc_codes().empty()) {
+            out << "DTC Codes:\n";
+            for (const auto& code : data.dtc_codes()) {
+                out << "  " << code.c_str() << "\n";
+            }
+        }
+    }
+
+    static void print_chassis(std::ostream& out, const ChassisData& data) {
+        out << "\n=== Chassis Data ===\n";
+        out << "Brake Pressure: " << data.brake_pressure() << " bar\n";
+        out << "Steering Angle: " << data.steering_angle() << "°\n";
+        out << "Suspension Height (FL,FR,RL,RR): ";
+        for (int i = 0; i < 4; i++) {
+            out << data.suspension_height()[i] << "mm ";
+        }
+        out << "\nWheel Speed (FL,FR,RL,RR): ";
+        for (int i = 0; i < 4; i++) {
+            out << data.wheel_speed()[i] << "km/h ";
+        }
+        out << "\nABS Active: " << (data.abs_active() ? "YES" : "NO") << "\n";
+        out << "Traction Control: " << (data.traction_control_active() ? "ON" : "OFF") << "\n";
+    }
+
+    static void print_battery(std::ostream& out, const BatteryData& data) {
+        out << "\n=== Battery Data ===\n";
+        out << "Voltage: " << data.voltage() << "V\n";
+        out << "Current: " << data.current() << "A\n";
+        out << "Temperature: " << data.temperature() << "°C\n";
+        out << "State of Charge: " << data.state_of_charge() << "%\n";
+        out << "Power Consumption: " << data.power_consumption() << "W\n";
+        out << "Charging Status: " << (data.charging_status() ? "Charging" : "Not Charging") << "\n";
+    }
+
+    static void print_adas(std::ostream& out, const ADASData& data) {
+        out << "\n=== ADAS Data ===\n";
+        out << "Forward Collision Distance: " << data.forward_collision_distance() << "m\n";
+        out << "Lane Deviation: " << data.lane_deviation() << "m\n";
+        out << "Lane Departure Warning: " << (data.lane_departure_warning() ? "ACTIVE" : "inactive") << "\n";
+        out << "Forward Collision Warning: " << (data.forward_collision_warning() ? "ACTIVE" : "inactive") << "\n";
+        out << "Blind Spot Warning (L/R): " 
+            << (data.blind_spot_warning_left() ? "LEFT " : "")
+            << (data.blind_spot_warning_right() ? "RIGHT" : "") << "\n";
+        out << "Adaptive Cruise Speed: " << data.adaptive_cruise_speed() << "km/h\n";
+        out << "Time to Collision: " << data.time_to_collision() << "s\n";
+    }
+
+    template<typename T>
+    static void print_receive_stats(const char* name, const RenderQueue<T>& queue,
+                                    AllocationStats& allocations) {
+        uint64_t allocs = 0;
+        uint64_t samples = 0;
+        allocations.take_window(allocs, samples);
+        std::cout << "  " << std::left << std::setw(12) << name << std::right
+                  << " received: " << std::setw(8) << queue.pushed()
+                  << " dropped: " << std::setw(6) << queue.dropped();
+        if (alloc_counter::enabled()) {
+            std::cout << " allocations: " << allocs << " for " << samples << " samples\n";
+        } else {
+            std::cout << " allocations: not counted (build with -DCOUNT_ALLOCATIONS=ON)\n";
+        }
+    }
+
+    // Drains every queue and, if anything changed, redraws the dashboard lines
+    // that differ from the previous frame
+    void render_frame() {
+        bool updated = powertrain_latest_.drain(powertrain_listener_.queue);
+        updated = chassis_latest_.drain(chassis_listener_.queue) || updated;
+        updated = battery_latest_.drain(battery_listener_.queue) || updated;
+        updated = adas_latest_.drain(adas_listener_.queue) || updated;
+
+        // A stalled topic sends nothing, so its warning changes the frame too
+        std::string stalled = stalled_topics();
+        if (stalled != stalled_shown_) {
+            stalled_shown_ = stalled;
+            updated = true;
+        }
+        if (!updated && !frame_.invalidated()) return;
+
+        std::ostream& out = frame_.begin();
+        if (!stalled.empty()) {
+            out << "!! Deadline missed, no samples from: " << stalled << "\n\n";
+        }
+        if (powertrain_latest_.valid) print_powertrain(out, powertrain_latest_.data);
+        if (chassis_latest_.valid) print_chassis(out, chassis_latest_.data);
+        if (battery_latest_.valid) print_battery(out, battery_latest_.data);
+        if (adas_latest_.valid) print_adas(out, adas_latest_.data);
+        frame_.present();
+    }
+
+    // Samples the reader-side filters evaluated: what arrived without having
+    // been filtered by the writer (data-sharing, or no writer-side filtering)
+    void print_filter_stats(const char* name, const char* type_name) {
+        const VehicleFilterCounters* counters = filter_factory_.counters(type_name);
+        uint64_t evaluated = counters->evaluated.load(std::memory_order_relaxed);
+        if (evaluated == 0) return;
+        std::cout << "  " << std::left << std::setw(12) << name << std::right
+                  << " filtered on receive: " << evaluated - counters->passed.load(std::memory_order_relaxed)
+                  << " of " << evaluated << " samples\n";
+    }
+
+    // Topics whose reader missed its deadline and got no sample since
+    std::string stalled_topics() const {
+        const std::pair<const char*, const TimedReaderListener*> listeners[] = {
+            {"powertrain", &powertrain_listener_}, {"chassis", &chassis_listener_},
+            {"battery", &battery_listener_}, {"adas", &adas_listener_}};
+        std::string topics;
+        for (const auto& entry : listeners) {
+            if (!entry.second->stalled()) continue;
+            if (!topics.empty()) topics += ", ";
+            topics += entry.first;
+        }
+        return topics;
+    }
+
+    void print_timing_stats(const char* name, const TimedReaderListener& listener) {
+        auto it = timing_.find(name);
+        ReaderTiming timing = it != timing_.end() ? it->second : ReaderTiming();
+        uint32_t incompatible = listener.incompatible_qos.load(std::memory_order_relaxed);
+        if (timing.min_separation_ms == 0 && timing.deadline_ms == 0 && incompatible == 0) return;
+
+        std::cout << "  " << std::left << std::setw(12) << name << std::right;
+        if (timing.min_separation_ms > 0) {
+            std::cout << " min separation " << timing.min_separation_ms << " ms: "
+                      << listener.separated.load(std::memory_order_relaxed) << " dropped";
+        }
+        if (timing.deadline_ms > 0) {
+            std::cout << " deadline " << timing.deadline_ms << " ms: "
+                      << listener.deadline_missed.load(std::memory_order_relaxed) << " missed"
+                      << (listener.stalled() ? " (stalled)" : "");
+        }
+        if (incompatible > 0) {
+            uint32_t policy = listener.incompatible_policy.load(std::memory_order_relaxed);
+            std::cout << " " << incompatible << " writer(s) not matched: "
+                      << (policy == DEADLINE_QOS_POLICY_ID ? "deadline shorter than offered"
+                                                           : "incompatible QoS policy " + std::to_string(policy));
+        }
+        std::cout << "\n";
+    }
+
+    void show_render_stats() {
+        std::cout << "\nReceive path (render " << render_loop_.fps()
+                  << " fps, allocations since the last 'stats'):\n";
+        print_receive_stats("powertrain", powertrain_listener_.queue, powertrain_listener_.allocations);
+        print_receive_stats("chassis", chassis_listener_.queue, chassis_listener_.allocations);
+        print_receive_stats("battery", battery_listener_.queue, battery_listener_.allocations);
+        print_receive_stats("adas", adas_listener_.queue, adas_listener_.allocations);
+        print_filter_stats("powertrain", "PowertrainData");
+        print_filter_stats("chassis", "ChassisData");
+        print_filter_stats("battery", "BatteryData");
+        print_filter_stats("adas", "ADASData");
+        print_timing_stats("powertrain", powertrain_listener_);
+        print_timing_stats("chassis", chassis_listener_);
+        print_timing_stats("battery", battery_listener_);
+        print_timing_stats("adas", adas_listener_);
+    }
+
  // 토픽 구독 상태 관리
     std::map<std::string, bool> topic_status_;  // true: 구독 중, false: 구독 안함
     std::mutex topic_mutex_;
 
-    // 토픽 구독/구독취소 함수
-    bool subscribe_topic(const std::string& topic_name) {
-        std::lock_guard<std::mutex> lock(topic_mutex_);
-        
-        if (topic_readers_.find(topic_name) != topic_readers_.end()) {
-            std::cout << "Already subscribed to " << topic_name << std::endl;
-            return true;
+    // Zero-copy mode: read chassis/battery samples in place via data-sharing
+    bool use_zero_copy_;
+    TransportOptions transport_;
+
+    // TIME_BASED_FILTER / DEADLINE of each topic's reader
+    std::map<std::string, ReaderTiming> timing_;
+
+    // WaitSet mode: readers have no listener. Application threads wait on the
+    // readers' status conditions and call the listener's take path themselves,
+    // so samples are processed on known (optionally pinned) threads.
+    // Topics are spread over the event loops; a WaitSet has a single waiter.
+    struct EventLoop {
+        WaitSet waitset;
+        GuardCondition wakeup;
+        std::thread thread;
+    };
+    std::vector<std::unique_ptr<EventLoop>> event_loops_;
+    int pin_cpu_;
+    std::atomic<bool> running_;
+
+    static size_t topic_index(const std::string& topic_name) {
+        if (topic_name == "powertrain") return 0;
+        if (topic_name == "chassis") return 1;
+        if (topic_name == "battery") return 2;
+        return 3;
+    }
+
+    EventLoop& event_loop_for(const std::string& topic_name) {
+        return *event_loops_[topic_index(topic_name) % event_loops_.size()];
+    }
+
+    void run_event_loop(size_t index) {
+        EventLoop& loop = *event_loops_[index];
+        if (pin_cpu_ >= 0) {
+            pin_current_thread(pin_cpu_ + static_cast<int>(index));
         }
 
-        TopicReader topic_reader;
+        ConditionSeq active_conditions;
+        while (running_) {
+            loop.waitset.wait(active_conditions, eprosima::fastrtps::Duration_t(1, 0));
+
+            // Readers are only deleted under topic_mutex_, so check the triggered
+            // conditions through the current reader table
+            std::lock_guard<std::mutex> lock(topic_mutex_);
+            for (auto& entry : topic_readers_) {
+                if (&event_loop_for(entry.first) != &loop) continue;
+                DataReader* reader = entry.second.reader;
+                TimedReaderListener* listener = entry.second.listener;
+                if (!reader->get_statuscondition().get_trigger_value()) continue;
+
+                StatusMask changes = reader->get_status_changes();
+                if (changes.is_active(StatusMask::requested_deadline_missed())) {
+                    RequestedDeadlineMissedStatus status;
+                    reader->get_requested_deadline_missed_status(status);
+                    listener->on_requested_deadline_missed(reader, status);
+                }
+                if (changes.is_active(StatusMask::requested_incompatible_qos())) {
+                    RequestedIncompatibleQosStatus status;
+                    reader->get_requested_incompatible_qos_status(status);
+                    listener->on_requested_incompatible_qos(reader, status);
+                }
+                if (changes.is_active(StatusMask::data_available())) {
+                    listener->on_data_available(reader);
+                }
+            }
+        }
+    }
+
+    void start_event_loops() {
+        for (size_t i = 0; i < event_loops_.size(); ++i) {
+            event_loops_[i]->thread = std::thread([this, i]() { run_event_loop(i); });
+        }
+    }
+
+    void stop_event_loops() {
+        running_ = false;
+        for (auto& loop : event_loops_) {
+            loop->wakeup.set_trigger_value(true);
+            if (loop->thread.joinable()) {
+                loop->thread.join();
+            }
+        }
+    }
+
+    // Creates a reader served either by its listener or by its event loop.
+    // Returns nullptr if the reader could not be created or attached; the
+    // caller then owns nothing to clean up.
+    DataReader* create_reader(TopicDescription* topic, const DataReaderQos& qos,
+                              DataReaderListener* listener, const std::string& topic_name) {
+        if (event_loops_.empty()) {
+            return subscriber_->create_datareader(topic, qos, listener);
+        }
+        DataReader* reader = subscriber_->create_datareader(topic, qos, nullptr, StatusMask::none());
+        if (reader == nullptr) return nullptr;
+
+        reader->get_statuscondition().set_enabled_statuses(StatusMask::data_available() <<
+                                                           StatusMask::requested_deadline_missed() <<
+                                                           StatusMask::requested_incompatible_qos());
+        if (event_loop_for(topic_name).waitset.attach_condition(reader->get_statuscondition()) !=
+                ReturnCode_t::RETCODE_OK) {
+            subscriber_->delete_datareader(reader);
+            return nullptr;
+        }
+        return reader;
+    }
+
+    // DataReader QoS for the plain topics (chassis, battery)
+    DataReaderQos plain_reader_qos() const {
+        DataReaderQos qos = DATAREADER_QOS_DEFAULT;
+        if (use_zero_copy_) {
+            qos.data_sharing().automatic();
+            qos.history().kind = KEEP_LAST_HISTORY_QOS;
+            qos.history().depth = 10;
+            qos.endpoint().history_memory_policy = eprosima::fastrtps::rtps::PREALLOCATED_MEMORY_MODE;
+        }
+        return qos;
+    }
+
+    static eprosima::fastrtps::Duration_t from_ms(uint32_t ms) {
+        return eprosima::fastrtps::Duration_t(static_cast<int32_t>(ms / 1000), (ms % 1000) * 1000000u);
+    }
+
+    // The writer has to offer a deadline at least as short as the requested
+    // one, otherwise the endpoints do not match
+    void apply_timing(const std::string& topic_name, DataReaderQos& qos) const {
+        auto it = timing_.find(topic_name);
+        if (it == timing_.end()) return;
+        if (it->second.min_separation_ms > 0) {
+            qos.time_based_filter().minimum_separation = from_ms(it->second.min_separation_ms);
+        }
+        if (it->second.deadline_ms > 0) {
+            qos.deadline().period = from_ms(it->second.deadline_ms);
+        }
+    }
+
+    // Creates the topic, the filtered topic if filter is not empty, and the reader
+    bool create_topic_reader(const std::string& topic_name, const std::string& filter, TopicReader& topic_reader) {
+        const char* dds_topic_name = nullptr;
+        DataReaderQos qos = DATAREADER_QOS_DEFAULT;
         if (topic_name == "powertrain") {
             topic_reader.type = TypeSupport(new PowertrainDataPubSubType());
-            topic_reader.type.register_type(participant_);
-            topic_reader.topic = participant_->create_topic("PowertrainTopic", "PowertrainData", TOPIC_QOS_DEFAULT);
-            topic_reader.reader = subscriber_->create_datareader(topic_reader.topic, DATAREADER_QOS_DEFAULT, &powertrain_listener_);
+            dds_topic_name = "PowertrainTopic";
+            topic_reader.listener = &powertrain_listener_;
         }
         else if (topic_name == "chassis") {
             topic_reader.type = TypeSupport(new ChassisDataPubSubType());
-            topic_reader.type.register_type(participant_);
-            topic_reader.topic = participant_->create_topic("ChassisTopic", "ChassisData", TOPIC_QOS_DEFAULT);
-            topic_reader.reader = subscriber_->create_datareader(topic_reader.topic, DATAREADER_QOS_DEFAULT, &chassis_listener_);
+            dds_topic_name = "ChassisTopic";
+            topic_reader.listener = &chassis_listener_;
+            qos = plain_reader_qos();
         }
         else if (topic_name == "battery") {
             topic_reader.type = TypeSupport(new BatteryDataPubSubType());
-            topic_reader.type.register_type(participant_);
-            topic_reader.topic = participant_->create_topic("BatteryTopic", "BatteryData", TOPIC_QOS_DEFAULT);
-            topic_reader.reader = subscriber_->create_datareader(topic_reader.topic, DATAREADER_QOS_DEFAULT, &battery_listener_);
+            dds_topic_name = "BatteryTopic";
+            topic_reader.listener = &battery_listener_;
+            qos = plain_reader_qos();
         }
         else if (topic_name == "adas") {
             topic_reader.type = TypeSupport(new ADASDataPubSubType());
-            topic_reader.type.register_type(participant_);
-            topic_reader.topic = participant_->create_topic("ADASTopic", "ADASData", TOPIC_QOS_DEFAULT);
-            topic_reader.reader = subscriber_->create_datareader(topic_reader.topic, DATAREADER_QOS_DEFAULT, &adas_listener_);
+            dds_topic_name = "ADASTopic";
+            topic_reader.listener = &adas_listener_;
         }
         else {
             std::cout << "Unknown topic: " << topic_name << std::endl;
             return false;
         }
 
+        apply_timing(topic_name, qos);
+
+        topic_reader.type.register_type(participant_);
+        topic_reader.topic = participant_->create_topic(dds_topic_name, topic_reader.type.get_type_name(), TOPIC_QOS_DEFAULT);
+        if (topic_reader.topic == nullptr) return false;
+
+        TopicDescription* description = topic_reader.topic;
+        if (!filter.empty()) {
+            topic_reader.filtered = participant_->create_contentfilteredtopic(
+                std::string(dds_topic_name) + "_Filtered", topic_reader.topic, filter, {}, kVehicleFilterClass);
+            if (topic_reader.filtered == nullptr) {
+                std::cout << "Invalid filter for " << topic_name << ": " << filter << std::endl;
+                participant_->delete_topic(topic_reader.topic);
+                return false;
+            }
+            topic_reader.filter = filter;
+            description = topic_reader.filtered;
+        }
+        topic_reader.reader = create_reader(description, qos, topic_reader.listener, topic_name);
+        if (topic_reader.reader == nullptr) {
+            std::cout << "Failed to create the reader of " << topic_name << std::endl;
+            if (topic_reader.filtered != nullptr) {
+                participant_->delete_contentfilteredtopic(topic_reader.filtered);
+            }
+            participant_->delete_topic(topic_reader.topic);
+            return false;
+        }
+        return true;
+    }
+
+    void delete_topic_reader(const std::string& topic_name, TopicReader& topic_reader) {
+        if (!event_loops_.empty()) {
+            event_loop_for(topic_name).waitset.detach_condition(topic_reader.reader->get_statuscondition());
+        }
+        subscriber_->delete_datareader(topic_reader.reader);
+        if (topic_reader.filtered != nullptr) {
+            participant_->delete_contentfilteredtopic(topic_reader.filtered);
+        }
+        participant_->delete_topic(topic_reader.topic);
+        topic_reader.listener->last_missed_at_ns = 0;
+    }
+
+    // 토픽 구독/구독취소 함수
+    // filter: content filter expression, e.g. "abs_active = TRUE" (empty: every sample).
+    // Subscribing again with another filter changes the filter of the reader.
+    bool subscribe_topic(const std::string& topic_name, const std::string& filter = std::string()) {
+        std::lock_guard<std::mutex> lock(topic_mutex_);
+        
+        auto it = topic_readers_.find(topic_name);
+        if (it != topic_readers_.end()) {
+            TopicReader& current = it->second;
+            if (current.filter == filter) {
+                std::cout << "Already subscribed to " << topic_name << std::endl;
+                return true;
+            }
+            // A filtered reader keeps its history, only the expression changes
+            if (current.filtered != nullptr && !filter.empty()) {
+                if (current.filtered->set_filter_expression(filter, {}) != ReturnCode_t::RETCODE_OK) {
+                    std::cout << "Invalid filter for " << topic_name << ": " << filter << std::endl;
+                    return false;
+                }
+                current.filter = filter;
+                std::cout << "Filter of " << topic_name << " set to: " << filter << std::endl;
+                return true;
+            }
+            // Switching between filtered and unfiltered needs a new reader
+            delete_topic_reader(topic_name, current);
+            topic_readers_.erase(it);
+            topic_status_[topic_name] = false;
+        }
+
+        TopicReader topic_reader;
+        if (!create_topic_reader(topic_name, filter, topic_reader)) {
+            return false;
+        }
+
         topic_readers_[topic_name] = topic_reader;
         topic_status_[topic_name] = true;
-        std::cout << "Successfully subscribed to " << topic_name << std::endl;
+        std::cout << "Successfully subscribed to " << topic_name;
+        if (!filter.empty()) std::cout << " where " << filter;
+        std::cout << std::endl;
         return true;
     }
 
@@ -181,8 +715,7 @@ private:
             return true;
         }
 
-        subscriber_->delete_datareader(it->second.reader);
-        participant_->delete_topic(it->second.topic);
+        delete_topic_reader(topic_name, it->second);
         topic_readers_.erase(it);
         topic_status_[topic_name] = false;
         
@@ -195,7 +728,12 @@ private:
         std::cout << "\nCurrent subscription status:\n";
         for (const auto& status : topic_status_) {
             std::cout << status.first << ": " 
-                     << (status.second ? "Subscribed" : "Unsubscribed") << std::endl;
+                     << (status.second ? "Subscribed" : "Unsubscribed");
+            auto it = topic_readers_.find(status.first);
+            if (it != topic_readers_.end() && !it->second.filter.empty()) {
+                std::cout << " (filter: " << it->second.filter << ")";
+            }
+            std::cout << std::endl;
         }
     }
 
@@ -203,13 +741,50 @@ private:
 
 
 public:
+    explicit VehicleSystemsSubscriber(const SubscriberOptions& options = SubscriberOptions())
+        : participant_(nullptr)
+        , subscriber_(nullptr)
+        , render_loop_(options.render_fps)
+        , use_zero_copy_(options.use_zero_copy)
+        , transport_(options.transport)
+        , timing_(options.timing)
+        , pin_cpu_(options.pin_cpu)
+        , running_(true) {
+        powertrain_listener_.max_batch = options.max_batch;
+        chassis_listener_.max_batch = options.max_batch;
+        battery_listener_.max_batch = options.max_batch;
+        adas_listener_.max_batch = options.max_batch;
+
+        const std::pair<const char*, TimedReaderListener*> listeners[] = {
+            {"powertrain", &powertrain_listener_}, {"chassis", &chassis_listener_},
+            {"battery", &battery_listener_}, {"adas", &adas_listener_}};
+        for (const auto& entry : listeners) {
+            auto it = timing_.find(entry.first);
+            if (it != timing_.end()) {
+                entry.second->min_separation_ns = static_cast<int64_t>(it->second.min_separation_ms) * 1000000;
+            }
+        }
+
+        for (int i = 0; i < options.waitset_threads; ++i) {
+            std::unique_ptr<EventLoop> loop(new EventLoop());
+            loop->waitset.attach_condition(loop->wakeup);
+            event_loops_.push_back(std::move(loop));
+        }
+    }
+
     bool init() {
         // Create participant
         DomainParticipantQos participantQos;
         participantQos.name("VehicleSystems_Subscriber");
+        apply_transport(participantQos, transport_);
         participant_ = DomainParticipantFactory::get_instance()->create_participant(0, participantQos);
         if (participant_ == nullptr) return false;
 
+        if (participant_->register_content_filter_factory(kVehicleFilterClass, &filter_factory_) !=
+                ReturnCode_t::RETCODE_OK) {
+            return false;
+        }
+
         // Create subscriber
         subscriber_ = participant_->create_subscriber(SUBSCRIBER_QOS_DEFAULT);
         if (subscriber_ == nullptr) return false;
@@ -221,16 +796,30 @@ public:
             subscribe_topic(topic);        // 모든 토픽 구독
         }
 
+        if (!event_loops_.empty()) {
+            start_event_loops();
+            std::cout << "WaitSet mode: " << event_loops_.size() << " event loop thread(s)";
+            if (pin_cpu_ >= 0) std::cout << " pinned from CPU " << pin_cpu_;
+            std::cout << std::endl;
+        }
+
         return true;
     }
 
     void run() {
+        render_loop_.start([this]() { render_frame(); });
+
         std::cout << "\nSubscriber running. Available commands:\n"
-                  << "subscribe <topic>   : Subscribe to a topic\n"
+                  << "subscribe <topic> [filter] : Subscribe to a topic, optionally only to the\n"
+                  << "                      samples matching a filter, e.g.\n"
+                  << "                      subscribe chassis abs_active = TRUE\n"
+                  << "                      subscribe powertrain engine_temperature > 90\n"
                   << "unsubscribe <topic> : Unsubscribe from a topic\n"
                   << "status             : Show current subscription status\n"
+                  << "stats              : Show received/dropped samples, allocations, filters and deadlines per topic\n"
                   << "quit               : Exit the program\n"
                   << "\nAvailable topics: powertrain, chassis, battery, adas\n" << std::endl;
+        frame_.invalidate();
 
         std::string command;
         std::string topic;
@@ -240,28 +829,106 @@ public:
             std::cin >> command;
 
             if (command == "quit") {
+                stop_event_loops();
+                render_loop_.stop();
                 break;
             }
             else if (command == "status") {
                 show_status();
             }
+            else if (command == "stats") {
+                show_render_stats();
+            }
             else if (command == "subscribe" || command == "unsubscribe") {
                 std::cin >> topic;
                 if (command == "subscribe") {
-                    subscribe_topic(topic);
+                    // The rest of the line is the filter expression
+                    std::string filter;
+                    std::getline(std::cin, filter);
+                    size_t first = filter.find_first_not_of(" \t");
+                    size_t last = filter.find_last_not_of(" \t\r");
+                    filter = first == std::string::npos ? std::string() : filter.substr(first, last - first + 1);
+                    subscribe_topic(topic, filter);
                 } else {
                     unsubscribe_topic(topic);
                 }
             }
             else {
-                std::cout << "Unknown command. Available commands: subscribe, unsubscribe, status, quit" << std::endl;
+                std::cout << "Unknown command. Available commands: subscribe, unsubscribe, status, stats, quit" << std::endl;
             }
+            // The echoed command and its output may have scrolled the dashboard
+            frame_.invalidate();
         }
     }
 };
 
-int main() {
-    VehicleSystemsSubscriber* subscriber = new VehicleSystemsSubscriber();
+// Parses "<topic>=<ms>" for one of the four topics
+static bool parse_topic_ms(const std::string& value, std::string& topic, uint32_t& ms) {
+    size_t sep = value.find('=');
+    if (sep == std::string::npos) return false;
+    topic = value.substr(0, sep);
+    if (topic != "powertrain" && topic != "chassis" && topic != "battery" && topic != "adas") return false;
+    ms = static_cast<uint32_t>(std::strtoul(value.c_str() + sep + 1, nullptr, 10));
+    return true;
+}
+
+int main(int argc, char** argv) {
+    SubscriberOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--zero-copy") {
+            options.use_zero_copy = true;
+        } else if (arg == "--fps" && i + 1 < argc) {
+            options.render_fps = std::atof(argv[++i]);
+        } else if (arg == "--waitset" && i + 1 < argc) {
+            options.waitset_threads = std::atoi(argv[++i]);
+        } else if (arg == "--pin-cpu" && i + 1 < argc) {
+            options.pin_cpu = std::atoi(argv[++i]);
+        } else if (arg == "--max-batch" && i + 1 < argc) {
+            options.max_batch = std::max(1, std::atoi(argv[++i]));
+        } else if ((arg == "--min-separation" || arg == "--deadline") && i + 1 < argc) {
+            std::string topic;
+            uint32_t ms = 0;
+            if (!parse_topic_ms(argv[++i], topic, ms)) {
+                std::cout << "Invalid " << arg << ": " << argv[i] << std::endl;
+                return 1;
+            }
+            if (arg == "--deadline") {
+                options.timing[topic].deadline_ms = ms;
+            } else {
+                options.timing[topic].min_separation_ms = ms;
+            }
+        } else if (!parse_transport_arg(argc, argv, i, options.transport)) {
+            std::cout << "Usage: " << argv[0] << " [options]\n"
+                      << "  --zero-copy : Read chassis/battery in place via data-sharing\n"
+                      << "                (their content filters are then evaluated on receive, not by the writer)\n"
+                      << "  --fps <n>   : Dashboard redraw rate (default 10)\n"
+                      << "  --waitset <n> : Take samples on n WaitSet threads (1-4) instead of listeners\n"
+                      << "  --pin-cpu <c> : Pin WaitSet thread i to CPU c+i\n"
+                      << "  --max-batch <n> : Samples taken per take() call (default 32)\n"
+                      << "  --min-separation <topic>=<ms> : Deliver at most one sample per interval (TIME_BASED_FILTER)\n"
+                      << "  --deadline <topic>=<ms> : Report a stalled publisher when no sample arrives within\n"
+                      << "                the period (DEADLINE, must not be shorter than the writer's offered deadline)\n"
+                      << transport_usage();
+            return 1;
+        }
+    }
+
+    // A reader cannot expect samples more often than it lets them through
+    for (const auto& entry : options.timing) {
+        const ReaderTiming& timing = entry.second;
+        if (timing.deadline_ms > 0 && timing.min_separation_ms > timing.deadline_ms) {
+            std::cout << entry.first << ": --min-separation must not exceed --deadline" << std::endl;
+            return 1;
+        }
+    }
+
+    if (options.waitset_threads < 0 || options.waitset_threads > 4) {
+        std::cout << "--waitset expects 1 to 4 threads (one per topic at most)" << std::endl;
+        return 1;
+    }
+
+    VehicleSystemsSubscriber* subscriber = new VehicleSystemsSubscriber(options);
     if (subscriber->init()) {
         subscriber->run();
     }
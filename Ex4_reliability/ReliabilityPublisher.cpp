@@ -1,5 +1,7 @@
 #include "ReliabilityTest.h"
 #include "ReliabilityTestPubSubTypes.h"
+#include "PeriodicScheduler.hpp"
+#include "LatencyHistogram.hpp"
 
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
 #include <fastdds/dds/domain/DomainParticipant.hpp>
@@ -7,8 +9,12 @@
 #include <fastdds/dds/publisher/Publisher.hpp>
 #include <fastdds/dds/publisher/DataWriter.hpp>
 #include <fastdds/dds/publisher/qos/DataWriterQos.hpp>
+#include <fastdds/rtps/flowcontrol/FlowControllerDescriptor.hpp>
+#include <fastdds/rtps/flowcontrol/FlowControllerSchedulerPolicy.hpp>
 
 #include <chrono>
+#include <cstdlib>
+#include <string>
 #include <thread>
 #include <iostream>
 #include <csignal>
@@ -18,13 +24,16 @@
 #include <pthread.h>
 #include <sys/types.h>
 #include <termios.h>
-#include <queue>
+#include <deque>
+#include <iomanip>
+#include <memory>
 
 using namespace eprosima::fastdds::dds;
 
 // 전역 변수를 volatile sig_atomic_t로 변경
 std::atomic<bool> g_is_paused{false};
 std::atomic<bool> g_running{true};
+std::atomic<bool> g_print_stats{false};
 
 // 키보드 입력을 비동기적으로 처리하는 함수
 void keyboard_control() {
@@ -45,6 +54,9 @@ void keyboard_control() {
                 g_is_paused = !g_is_paused;
                 std::cout << (g_is_paused ? "Publisher PAUSED" : "Publisher RESUMED") << std::endl;
             }
+            else if (c == 's' || c == 'S') {  // 's' 키로 write 통계 출력
+                g_print_stats = true;
+            }
             else if (c == 'q' || c == 'Q') {  // 'q' 키로 종료
                 g_running = false;
                 std::cout << "Stopping publisher..." << std::endl;
@@ -56,6 +68,24 @@ void keyboard_control() {
     tcsetattr(STDIN_FILENO, TCSANOW, &old_tio);
 }
 
+// Writer-side flow control (--async)
+const char* const kFlowControllerName = "reliability_flow_controller";
+
+struct FlowOptions {
+    bool async;                  // ASYNCHRONOUS_PUBLISH_MODE through a flow controller
+    int32_t max_bytes_per_period;
+    uint64_t period_ms;
+    eprosima::fastdds::rtps::FlowControllerSchedulerPolicy scheduler;
+    size_t pause_queue_limit;    // critical messages kept while paused
+
+    FlowOptions()
+        : async(false)
+        , max_bytes_per_period(64 * 1024)
+        , period_ms(100)
+        , scheduler(eprosima::fastdds::rtps::FlowControllerSchedulerPolicy::PRIORITY)
+        , pause_queue_limit(1000) {}
+};
+
 class ReliabilityPublisher {
     
 private:
@@ -68,11 +98,49 @@ private:
     TypeSupport type_;
     TestData data_;
     uint32_t sequence_number_;
-    std::queue<TestData> paused_reliable_messages;
+    FlowOptions flow_;
+
+    // Bounded: the oldest message is dropped when the pause outlasts the limit
+    std::deque<TestData> paused_reliable_messages;
+    size_t paused_max_depth_;
+    uint64_t paused_dropped_;
+
+    // Time spent inside DataWriter::write(), per writer (publishing thread only)
+    LatencyHistogram reliable_write_ns_;
+    LatencyHistogram best_effort_write_ns_;
+
+    static bool timed_write(DataWriter* writer, TestData& data, LatencyHistogram& blocked) {
+        auto start = std::chrono::steady_clock::now();
+        bool ok = writer->write(&data);
+        blocked.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+        return ok;
+    }
+
+    void print_write_stats() {
+        std::cout << "write() blocking (us)   p50      p99      max     count\n"
+                  << std::fixed << std::setprecision(1);
+        const LatencyHistogram* histograms[] = {&reliable_write_ns_, &best_effort_write_ns_};
+        const char* names[] = {"RELIABLE   ", "BEST_EFFORT"};
+        for (int i = 0; i < 2; ++i) {
+            std::cout << "  " << names[i] << std::setw(12) << histograms[i]->percentile(50.0) / 1000.0
+                      << std::setw(9) << histograms[i]->percentile(99.0) / 1000.0
+                      << std::setw(9) << histograms[i]->max() / 1000.0
+                      << std::setw(10) << histograms[i]->count() << "\n";
+        }
+        std::cout << "Pause queue depth: " << paused_reliable_messages.size()
+                  << " (max " << paused_max_depth_ << ", limit " << flow_.pause_queue_limit
+                  << ", dropped " << paused_dropped_ << ")\n"
+                  << "Publish mode: " << (flow_.async ? "ASYNCHRONOUS" : "SYNCHRONOUS");
+        if (flow_.async) {
+            std::cout << ", " << flow_.max_bytes_per_period << " bytes per " << flow_.period_ms << " ms";
+        }
+        std::cout << std::endl;
+    }
 
 
 public:
-    ReliabilityPublisher()
+    explicit ReliabilityPublisher(const FlowOptions& flow = FlowOptions())
         : participant_(nullptr)
         , publisher_(nullptr)
         , reliable_topic_(nullptr)
@@ -80,7 +148,10 @@ public:
         , reliable_writer_(nullptr)
         , best_effort_writer_(nullptr)
         , type_(new TestDataPubSubType())
-        , sequence_number_(0) {
+        , sequence_number_(0)
+        , flow_(flow)
+        , paused_max_depth_(0)
+        , paused_dropped_(0) {
     }
 
     ~ReliabilityPublisher() {
@@ -104,6 +175,20 @@ public:
     bool init() {
         DomainParticipantQos participantQos;
         participantQos.name("Reliability_Publisher");
+
+        // One flow controller shared by both writers. It sends at most
+        // max_bytes_per_period every period_ms, so a burst of write() calls
+        // (e.g. the flush after a pause) is spread out instead of saturating
+        // the link. With the priority scheduler RELIABLE samples go first.
+        if (flow_.async) {
+            auto flow_controller = std::make_shared<eprosima::fastdds::rtps::FlowControllerDescriptor>();
+            flow_controller->name = kFlowControllerName;
+            flow_controller->scheduler = flow_.scheduler;
+            flow_controller->max_bytes_per_period = flow_.max_bytes_per_period;
+            flow_controller->period_ms = flow_.period_ms;
+            participantQos.flow_controllers().push_back(flow_controller);
+        }
+
         participant_ = DomainParticipantFactory::get_instance()->create_participant(0, participantQos);
         if (participant_ == nullptr) return false;
 
@@ -122,12 +207,18 @@ public:
         DataWriterQos reliable_qos = DATAWRITER_QOS_DEFAULT;
         reliable_qos.reliability().kind = RELIABLE_RELIABILITY_QOS;
         reliable_qos.history().kind = KEEP_ALL_HISTORY_QOS;
+        if (flow_.async) {
+            set_async(reliable_qos, "-1");
+        }
         reliable_writer_ = publisher_->create_datawriter(reliable_topic_, reliable_qos);
 
         // Configure BEST_EFFORT QoS
         DataWriterQos best_effort_qos = DATAWRITER_QOS_DEFAULT;
         best_effort_qos.reliability().kind = BEST_EFFORT_RELIABILITY_QOS;
         best_effort_qos.history().kind = KEEP_ALL_HISTORY_QOS;
+        if (flow_.async) {
+            set_async(best_effort_qos, "1");
+        }
         best_effort_writer_ = publisher_->create_datawriter(best_effort_topic_, best_effort_qos);
 
         if (reliable_writer_ == nullptr || best_effort_writer_ == nullptr) return false;
@@ -135,6 +226,13 @@ public:
         return true;
     }
 
+    // Lower value = higher priority (-10..10), used by the PRIORITY scheduler
+    static void set_async(DataWriterQos& qos, const std::string& priority) {
+        qos.publish_mode().kind = ASYNCHRONOUS_PUBLISH_MODE;
+        qos.publish_mode().flow_controller_name = kFlowControllerName;
+        qos.properties().properties().emplace_back("fastdds.sfc.priority", priority);
+    }
+
     bool publish() {
         
 
@@ -151,36 +249,135 @@ public:
 
         if (!g_is_paused) {
             // 일시정지 해제 시, 쌓여있던 reliable 메시지들 먼저 전송
+            // (in async mode the flow controller paces them on the wire)
             while (!paused_reliable_messages.empty()) {
-                reliable_writer_->write(&paused_reliable_messages.front());
+                timed_write(reliable_writer_, paused_reliable_messages.front(), reliable_write_ns_);
                 std::cout << "Sending queued message: " 
                           << paused_reliable_messages.front().message() << std::endl;
-                paused_reliable_messages.pop();
+                paused_reliable_messages.pop_front();
             }
             
             // 현재 메시지 전송
-            reliable_writer_->write(&data_);
-            best_effort_writer_->write(&data_);
+            timed_write(reliable_writer_, data_, reliable_write_ns_);
+            timed_write(best_effort_writer_, data_, best_effort_write_ns_);
             
             std::cout << "Published " << msg << std::endl;
         } else {
             // 일시정지 중에는 reliable 메시지만 큐에 저장
             if (data_.is_critical()) {
-                paused_reliable_messages.push(data_);
+                if (paused_reliable_messages.size() >= flow_.pause_queue_limit) {
+                    paused_reliable_messages.pop_front();
+                    paused_dropped_++;
+                }
+                paused_reliable_messages.push_back(data_);
+                if (paused_reliable_messages.size() > paused_max_depth_) {
+                    paused_max_depth_ = paused_reliable_messages.size();
+                }
                 std::cout << "Queued critical message: " << msg << std::endl;
             } else {
                 std::cout << "Skipped non-critical message while paused: " << msg << std::endl;
             }
         }
         
+        if (g_print_stats.exchange(false)) {
+            print_write_stats();
+        }
+
         std::cout.flush();
         sequence_number_++;
         return true;
     }
 
+    // Stress mode: writes TestData to both topics at 'rate' messages per
+    // second each (0 = as fast as write() returns). Writes are issued in
+    // 1 ms ticks, as many per tick as needed to stay on the target rate.
+    // Each writer numbers only the samples it accepted, so a write that
+    // times out on a full RELIABLE history is not reported as network loss
+    // by the subscriber.
+    void run_stress(double rate, size_t payload) {
+        typedef std::chrono::steady_clock Clock;
+
+        std::cout << "Stress publisher: "
+                  << (rate > 0.0 ? std::to_string(static_cast<uint64_t>(rate)) + " msg/s" : std::string("unthrottled"))
+                  << " per topic, " << payload << " byte payload. Press 'p' to pause, 's' for write stats, 'q' to quit."
+                  << std::endl;
+
+        std::thread keyboard_thread(keyboard_control);
+
+        TestData reliable_data;
+        TestData best_effort_data;
+        reliable_data.message(std::string(payload, 'x'));
+        best_effort_data.message(std::string(payload, 'x'));
+        uint32_t reliable_seq = 0;
+        uint32_t best_effort_seq = 0;
+        uint64_t reliable_failed = 0;
+        uint64_t best_effort_failed = 0;
+        uint32_t reported_reliable = 0;
+        uint32_t reported_best_effort = 0;
+
+        PeriodicTimer timer(std::chrono::milliseconds(1));
+        Clock::time_point start = Clock::now();
+        Clock::time_point next_report = start + std::chrono::seconds(1);
+        uint64_t attempted = 0;
+
+        while (g_running) {
+            uint64_t target = attempted + 1000;
+            if (rate > 0.0) {
+                target = static_cast<uint64_t>(std::chrono::duration<double>(Clock::now() - start).count() * rate);
+                // Blocked writes fall behind; catch up at most one second's worth
+                uint64_t max_backlog = static_cast<uint64_t>(rate) + 1;
+                if (target > attempted + max_backlog) attempted = target - max_backlog;
+            }
+
+            for (; attempted < target && g_running; ++attempted) {
+                if (g_is_paused) continue;
+                uint64_t now_ns = std::chrono::system_clock::now().time_since_epoch().count();
+
+                reliable_data.timestamp(now_ns);
+                reliable_data.sequence_number(reliable_seq);
+                if (timed_write(reliable_writer_, reliable_data, reliable_write_ns_)) {
+                    reliable_seq++;
+                } else {
+                    reliable_failed++;
+                }
+
+                best_effort_data.timestamp(now_ns);
+                best_effort_data.sequence_number(best_effort_seq);
+                if (timed_write(best_effort_writer_, best_effort_data, best_effort_write_ns_)) {
+                    best_effort_seq++;
+                } else {
+                    best_effort_failed++;
+                }
+            }
+
+            Clock::time_point now = Clock::now();
+            if (now >= next_report) {
+                std::cout << "Sent/s RELIABLE " << reliable_seq - reported_reliable
+                          << " (failed writes " << reliable_failed << ")"
+                          << ", BEST_EFFORT " << best_effort_seq - reported_best_effort
+                          << " (failed writes " << best_effort_failed << ")" << std::endl;
+                reported_reliable = reliable_seq;
+                reported_best_effort = best_effort_seq;
+                if (g_print_stats.exchange(false)) {
+                    print_write_stats();
+                }
+                next_report += std::chrono::seconds(1);
+            }
+
+            if (rate > 0.0) {
+                timer.wait();
+            }
+        }
+
+        if (keyboard_thread.joinable()) {
+            keyboard_thread.join();
+        }
+    }
+
     void run() {
         std::cout << "Publisher running. Commands:\n"
                   << "- Press 'p' to toggle pause\n"
+                  << "- Press 's' to show write() blocking time and pause queue depth\n"
                   << "- Press 'q' to quit\n"
                   << "PID: " << getpid() << std::endl;
         std::cout.flush();
@@ -188,23 +385,68 @@ public:
         // 키보드 입력을 처리할 스레드 시작
         std::thread keyboard_thread(keyboard_control);
 
+        PeriodicTimer timer(std::chrono::seconds(1));
         while (g_running) {
             publish();
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+            timer.wait();
         }
 
         // 키보드 스레드 종료 대기
         if (keyboard_thread.joinable()) {
             keyboard_thread.join();
         }
+        print_write_stats();
     }
 };
 
-int main() {
+int main(int argc, char** argv) {
+    // --stress <rate>: blast both topics at <rate> msg/s each (0 = unthrottled)
+    // --payload <bytes>: message size in stress mode
+    // --async: asynchronous publish mode through a flow controller
+    // --flow-bytes <n> / --flow-period <ms>: flow controller budget (64 KB per 100 ms)
+    // --scheduler fifo|round-robin|priority: flow controller scheduler (priority)
+    // --pause-queue <n>: critical messages kept while paused (1000)
+    bool stress = false;
+    double rate = 0.0;
+    size_t payload = 64;
+    FlowOptions flow;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--stress" && has_value) {
+            stress = true;
+            rate = std::atof(argv[++i]);
+        } else if (arg == "--payload" && has_value) {
+            payload = static_cast<size_t>(std::atol(argv[++i]));
+        } else if (arg == "--async") {
+            flow.async = true;
+        } else if (arg == "--flow-bytes" && has_value) {
+            flow.max_bytes_per_period = std::atoi(argv[++i]);
+        } else if (arg == "--flow-period" && has_value) {
+            flow.period_ms = static_cast<uint64_t>(std::atol(argv[++i]));
+        } else if (arg == "--scheduler" && has_value) {
+            std::string name = argv[++i];
+            if (name == "fifo") {
+                flow.scheduler = eprosima::fastdds::rtps::FlowControllerSchedulerPolicy::FIFO;
+            } else if (name == "round-robin") {
+                flow.scheduler = eprosima::fastdds::rtps::FlowControllerSchedulerPolicy::ROUND_ROBIN;
+            } else {
+                flow.scheduler = eprosima::fastdds::rtps::FlowControllerSchedulerPolicy::PRIORITY;
+            }
+        } else if (arg == "--pause-queue" && has_value) {
+            long value = std::atol(argv[++i]);
+            flow.pause_queue_limit = value > 0 ? static_cast<size_t>(value) : flow.pause_queue_limit;
+        }
+    }
+
     try {
-        ReliabilityPublisher publisher;
+        ReliabilityPublisher publisher(flow);
         if (publisher.init()) {
-            publisher.run();
+            if (stress) {
+                publisher.run_stress(rate, payload);
+            } else {
+                publisher.run();
+            }
         }
     }
     catch (const std::exception& e) {
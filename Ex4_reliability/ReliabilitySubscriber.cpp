@@ -1,5 +1,9 @@
 #include "ReliabilityTest.h"
 #include "ReliabilityTestPubSubTypes.h"
+#include "RenderQueue.hpp"
+#include "BatchTake.hpp"
+#include "GapTracker.hpp"
+#include "LatencyHistogram.hpp"
 
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
 #include <fastdds/dds/domain/DomainParticipant.hpp>
@@ -10,83 +14,220 @@
 #include <fastdds/dds/subscriber/qos/DataReaderQos.hpp>
 #include <fastdds/dds/subscriber/SampleInfo.hpp>
 
-#include <map>
-#include <set>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <string>
+#include <utility>
+#include <vector>
 #include <mutex>
 #include <iostream>
 
 using namespace eprosima::fastdds::dds;
 
+// Counters of one stress report interval, handed over by take_window()
+struct ReliabilityWindow {
+    uint64_t delivered;
+    uint64_t bytes;        // message payload
+    int64_t unrecovered;   // change of missing + lost sequences
+    uint64_t duplicates;
+    uint64_t reordered;
+    uint64_t repaired;     // received after a later sequence (NACK repair)
+    LatencyHistogram latency;  // source -> reception, every sample
+    LatencyHistogram repair;   // source -> reception, repaired samples
+    uint64_t total_received;
+    uint64_t total_expected;
+    double loss_rate;
+
+    ReliabilityWindow() { clear(); }
+
+    void clear() {
+        delivered = bytes = duplicates = reordered = repaired = 0;
+        unrecovered = 0;
+        total_received = total_expected = 0;
+        loss_rate = 0.0;
+        latency.reset();
+        repair.reset();
+    }
+};
+
 class ReliabilityListener : public DataReaderListener {
 private:
     std::string topic_name_;
-    std::map<uint32_t, bool> received_sequences_;
-    std::set<uint32_t> missing_sequences_;
+    GapTracker gaps_;
     std::mutex mutex_;
-    uint32_t last_continuous_seq_;
+    int32_t max_batch_;
+    uint64_t critical_count_;
+
+    // Stress statistics of the current interval
+    ReliabilityWindow window_;
+    uint64_t reported_unrecovered_;
+    uint64_t reported_duplicates_;
+    uint64_t reported_reordered_;
+
+    // Reception times of the last delivered samples. A RELIABLE reader
+    // delivers in order, so a sample that was repaired by a retransmission
+    // shows up as one received later than the samples delivered after it.
+    struct Reception {
+        int64_t source_ns;
+        int64_t reception_ns;
+        bool repaired;
+    };
+    static const size_t kRecentSamples = 256;
+    Reception recent_[kRecentSamples];
+    size_t recent_count_;
+    size_t recent_pos_;
+
+    void account_reception(int64_t source_ns, int64_t reception_ns) {
+        // Every recent sample received after this one was a repair
+        for (size_t n = 0; n < recent_count_; ++n) {
+            Reception& previous = recent_[(recent_pos_ + kRecentSamples - 1 - n) % kRecentSamples];
+            if (previous.reception_ns <= reception_ns) break;
+            if (previous.repaired) continue;
+            previous.repaired = true;
+            window_.repaired++;
+            window_.repair.record(static_cast<uint64_t>(previous.reception_ns - previous.source_ns));
+        }
+
+        Reception& slot = recent_[recent_pos_];
+        slot.source_ns = source_ns;
+        slot.reception_ns = reception_ns;
+        slot.repaired = false;
+        recent_pos_ = (recent_pos_ + 1) % kRecentSamples;
+        if (recent_count_ < kRecentSamples) recent_count_++;
+
+        if (reception_ns > source_ns) {
+            window_.latency.record(static_cast<uint64_t>(reception_ns - source_ns));
+        }
+    }
+
+    // Last received sample, and whether anything arrived since the last render()
+    uint32_t last_seq_;
+    bool last_is_critical_;
+    uint32_t last_critical_seq_;
+    bool updated_;
 
 public:
-    ReliabilityListener(const std::string& topic_name) 
+    ReliabilityListener(const std::string& topic_name, int32_t max_batch = kDefaultMaxBatch,
+                        size_t window = 65536)
         : topic_name_(topic_name)
-        , last_continuous_seq_(0) {
+        , gaps_(window)
+        , max_batch_(max_batch)
+        , critical_count_(0)
+        , reported_unrecovered_(0)
+        , reported_duplicates_(0)
+        , reported_reordered_(0)
+        , recent_count_(0)
+        , recent_pos_(0)
+        , last_seq_(0)
+        , last_is_critical_(false)
+        , last_critical_seq_(0)
+        , updated_(false) {
     }
 
     void on_data_available(DataReader* reader) override {
-        TestData data;
-        SampleInfo info;
-        while (reader->take_next_sample(&data, &info) == ReturnCode_t::RETCODE_OK) {
-            if (info.valid_data) {
-                std::lock_guard<std::mutex> lock(mutex_);
-                uint32_t seq = data.sequence_number();
-                received_sequences_[seq] = data.is_critical();
-
-                // 첫 메시지인 경우 초기화
-                if (received_sequences_.size() == 1) {
-                    last_continuous_seq_ = seq - 1;  // 현재 시퀀스 이전부터 시작
-                }
-
-                // Update continuous sequence
-                while (received_sequences_.find(last_continuous_seq_ + 1) != received_sequences_.end()) {
-                    last_continuous_seq_++;
-                }
-
-                // Find missing sequences
-                missing_sequences_.clear();
-                if (!received_sequences_.empty()) {
-                    uint32_t first_seq = received_sequences_.begin()->first;
-                    uint32_t last_seq = received_sequences_.rbegin()->first;
-                    for (uint32_t i = first_seq; i <= last_seq; i++) {
-                        if (received_sequences_.find(i) == received_sequences_.end()) {
-                            missing_sequences_.insert(i);
-                        }
-                    }
-                }
-
-                // Print status
-                std::cout << "\n=== " << topic_name_ << " Status ===\n"
-                         << "Received message #" << seq 
-                         << (data.is_critical() ? " (CRITICAL)" : "") << "\n"
-                         << "Total messages received: " << received_sequences_.size() << "\n"
-                         << "Missing sequences: ";
-
-                if (missing_sequences_.empty()) {
-                    std::cout << "None";
-                } else {
-                    for (auto missing : missing_sequences_) {
-                        std::cout << missing << " ";
-                    }
-                }
-                std::cout << std::endl;
-
-                // Print critical messages status
-                std::cout << "Critical messages status:" << std::endl;
-                for (const auto& pair : received_sequences_) {
-                    if (pair.second) {
-                        std::cout << "Critical message #" << pair.first << " received" << std::endl;
-                    }
-                }
+        take_batches<TestData>(reader, max_batch_, [this](const TestData& data, const SampleInfo& info) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // O(1) per sample; memory is bounded by the tracker window
+            gaps_.on_sequence(data.sequence_number());
+
+            window_.delivered++;
+            window_.bytes += data.message().size();
+            account_reception(info.source_timestamp.to_ns(), info.reception_timestamp.to_ns());
+
+            if (data.is_critical()) {
+                critical_count_++;
+                last_critical_seq_ = data.sequence_number();
+            }
+            last_seq_ = data.sequence_number();
+            last_is_critical_ = data.is_critical();
+            updated_ = true;
+        });
+    }
+
+    // Hands the counters of the interval since the previous call to 'out'
+    void take_window(ReliabilityWindow& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t unrecovered = gaps_.missing() + gaps_.lost();
+        window_.unrecovered = static_cast<int64_t>(unrecovered - reported_unrecovered_);
+        window_.duplicates = gaps_.duplicates() - reported_duplicates_;
+        window_.reordered = gaps_.reordered() - reported_reordered_;
+        reported_unrecovered_ = unrecovered;
+        reported_duplicates_ = gaps_.duplicates();
+        reported_reordered_ = gaps_.reordered();
+        window_.total_received = gaps_.received();
+        window_.total_expected = gaps_.expected();
+        window_.loss_rate = gaps_.loss_rate();
+
+        std::swap(out, window_);
+        window_.clear();
+    }
+
+    // Called from the render thread. Every sample is still accounted for on
+    // the receive thread (a dropped sample would show up as a lost one), but
+    // only a copy of the status is taken under the lock; printing happens
+    // outside it so the receive thread never waits for the terminal.
+    void render() {
+        uint32_t seq;
+        bool is_critical;
+        uint64_t critical_count;
+        uint32_t last_critical_seq;
+        uint64_t received, expected, missing, lost, gaps, duplicates, reordered, max_depth, too_late;
+        double loss_rate;
+        std::vector<std::pair<uint64_t, uint64_t>> ranges;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!updated_) return;
+            updated_ = false;
+
+            seq = last_seq_;
+            is_critical = last_is_critical_;
+            critical_count = critical_count_;
+            last_critical_seq = last_critical_seq_;
+            received = gaps_.received();
+            expected = gaps_.expected();
+            missing = gaps_.missing();
+            lost = gaps_.lost();
+            gaps = gaps_.gaps();
+            duplicates = gaps_.duplicates();
+            reordered = gaps_.reordered();
+            max_depth = gaps_.max_reorder_depth();
+            too_late = gaps_.too_late();
+            loss_rate = gaps_.loss_rate();
+            ranges = gaps_.missing_ranges(10);
+        }
+
+        // Print status
+        std::cout << "\n=== " << topic_name_ << " Status ===\n"
+                 << "Received message #" << seq 
+                 << (is_critical ? " (CRITICAL)" : "") << "\n"
+                 << "Total messages received: " << received << " of " << expected
+                 << " (loss " << loss_rate * 100.0 << "%)\n"
+                 << "Missing: " << missing << " in " << gaps << " gap(s), "
+                 << lost << " lost beyond the window\n"
+                 << "Duplicates: " << duplicates << ", reordered: " << reordered
+                 << " (max depth " << max_depth << "), too late: " << too_late << "\n"
+                 << "Missing sequences: ";
+
+        if (ranges.empty()) {
+            std::cout << "None";
+        } else {
+            for (const auto& range : ranges) {
+                std::cout << range.first;
+                if (range.second != range.first) std::cout << "-" << range.second;
+                std::cout << " ";
             }
+            if (ranges.size() < gaps) std::cout << "...";
+        }
+        std::cout << "\n";
+
+        // Print critical messages status
+        std::cout << "Critical messages received: " << critical_count;
+        if (critical_count > 0) {
+            std::cout << " (last #" << last_critical_seq << ")";
         }
+        std::cout << "\n";
+        std::cout.flush();
     }
 };
 
@@ -101,9 +242,65 @@ private:
     TypeSupport type_;
     ReliabilityListener reliable_listener_;
     ReliabilityListener best_effort_listener_;
+    RenderLoop render_loop_;
+    bool stress_;
+    std::chrono::steady_clock::time_point last_report_;
+
+    // One stress report line: a label and the value for each QoS side
+    template<typename Fn>
+    static void print_row(const char* label, const ReliabilityWindow& reliable,
+                          const ReliabilityWindow& best_effort, Fn value) {
+        std::cout << std::left << std::setw(28) << label << std::right
+                  << std::setw(16) << value(reliable)
+                  << std::setw(16) << value(best_effort) << "\n";
+    }
+
+    // Per-second side-by-side report of both QoS settings (--stress)
+    void render_stress() {
+        ReliabilityWindow reliable, best_effort;
+        reliable_listener_.take_window(reliable);
+        best_effort_listener_.take_window(best_effort);
+
+        auto now = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(now - last_report_).count();
+        last_report_ = now;
+        if (seconds <= 0.0) return;
+
+        std::cout << "\033[2J\033[H";
+        std::cout << std::left << std::setw(28) << "=== Stress report ===" << std::right
+                  << std::setw(16) << "RELIABLE" << std::setw(16) << "BEST_EFFORT" << "\n";
+        std::cout << std::fixed << std::setprecision(1);
+        print_row("Delivered (msg/s)", reliable, best_effort,
+                  [seconds](const ReliabilityWindow& w) { return w.delivered / seconds; });
+        print_row("Throughput (MB/s)", reliable, best_effort,
+                  [seconds](const ReliabilityWindow& w) { return w.bytes / seconds / 1e6; });
+        print_row("Lost, net of repairs (/s)", reliable, best_effort,
+                  [seconds](const ReliabilityWindow& w) { return w.unrecovered / seconds; });
+        print_row("Duplicated (/s)", reliable, best_effort,
+                  [seconds](const ReliabilityWindow& w) { return w.duplicates / seconds; });
+        print_row("Reordered (/s)", reliable, best_effort,
+                  [seconds](const ReliabilityWindow& w) { return w.reordered / seconds; });
+        print_row("Latency p50 (us)", reliable, best_effort,
+                  [](const ReliabilityWindow& w) { return w.latency.percentile(50.0) / 1000.0; });
+        print_row("Latency p99 (us)", reliable, best_effort,
+                  [](const ReliabilityWindow& w) { return w.latency.percentile(99.0) / 1000.0; });
+        print_row("Repaired (/s)", reliable, best_effort,
+                  [seconds](const ReliabilityWindow& w) { return w.repaired / seconds; });
+        print_row("Repair latency p50 (us)", reliable, best_effort,
+                  [](const ReliabilityWindow& w) { return w.repair.percentile(50.0) / 1000.0; });
+        print_row("Repair latency max (us)", reliable, best_effort,
+                  [](const ReliabilityWindow& w) { return w.repair.max() / 1000.0; });
+        print_row("Received total", reliable, best_effort,
+                  [](const ReliabilityWindow& w) { return static_cast<double>(w.total_received); });
+        std::cout << std::setprecision(3);
+        print_row("Loss rate total (%)", reliable, best_effort,
+                  [](const ReliabilityWindow& w) { return w.loss_rate * 100.0; });
+        std::cout << "\nPress Enter to stop." << std::endl;
+    }
 
 public:
-    ReliabilitySubscriber()
+    explicit ReliabilitySubscriber(int32_t max_batch = kDefaultMaxBatch, size_t window = 65536,
+                                   bool stress = false)
         : participant_(nullptr)
         , subscriber_(nullptr)
         , reliable_topic_(nullptr)
@@ -111,8 +308,10 @@ public:
         , reliable_reader_(nullptr)
         , best_effort_reader_(nullptr)
         , type_(new TestDataPubSubType())
-        , reliable_listener_("RELIABLE")
-        , best_effort_listener_("BEST_EFFORT") {
+        , reliable_listener_("RELIABLE", max_batch, window)
+        , best_effort_listener_("BEST_EFFORT", max_batch, window)
+        , render_loop_(stress ? 1.0 : 10.0)
+        , stress_(stress) {
     }
 
     ~ReliabilitySubscriber() {
@@ -168,15 +367,41 @@ public:
     }
 
     void run() {
+        if (stress_) {
+            last_report_ = std::chrono::steady_clock::now();
+            render_loop_.start([this]() { render_stress(); });
+        } else {
+            render_loop_.start([this]() {
+                reliable_listener_.render();
+                best_effort_listener_.render();
+            });
+        }
+
         std::cout << "Subscriber is running. Press Enter to stop." << std::endl;
         std::cin.ignore();
         std::cin.get();
+
+        render_loop_.stop();
     }
 };
 
-int main() {
+int main(int argc, char** argv) {
     try {
-        ReliabilitySubscriber subscriber;
+        // --window <n>: sequences kept by the gap tracker before a gap counts as lost
+        // --stress: per-second loss/reorder/latency report for the publisher's stress mode
+        size_t window = 65536;
+        bool stress = false;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--window" && i + 1 < argc) {
+                long value = std::atol(argv[i + 1]);
+                if (value > 0) window = static_cast<size_t>(value);
+            } else if (arg == "--stress") {
+                stress = true;
+            }
+        }
+
+        ReliabilitySubscriber subscriber(parse_max_batch(argc, argv), window, stress);
         if (subscriber.init()) {
             subscriber.run();
         }
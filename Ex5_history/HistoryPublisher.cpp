@@ -1,5 +1,6 @@
 #include "HistoryTest.h"
 #include "HistoryTestPubSubTypes.h"
+#include "PeriodicScheduler.hpp"
 
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
 #include <fastdds/dds/domain/DomainParticipant.hpp>
@@ -138,17 +139,19 @@ public:
             }
         });
 
+        // Normal mode: 1 sample per second, Burst mode: 10 samples per second
+        const std::chrono::milliseconds normal_period(1000);
+        const std::chrono::milliseconds burst_period(100);
+        bool timer_burst = burst_mode_;
+        PeriodicTimer timer(timer_burst ? burst_period : normal_period);
+
         while (running_) {
-            if (burst_mode_) {
-                // Burst mode: 10 samples per second
-                for (int i = 0; i < 10 && burst_mode_ && running_; ++i) {
-                    publish();
-                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                }
-            } else {
-                // Normal mode: 1 sample per second
-                publish();
-                std::this_thread::sleep_for(std::chrono::seconds(1));
+            publish();
+            timer.wait();
+
+            if (burst_mode_ != timer_burst) {
+                timer_burst = burst_mode_;
+                timer.set_period(timer_burst ? burst_period : normal_period);
             }
         }
 
@@ -1,5 +1,10 @@
 #include "HistoryTest.h"
 #include "HistoryTestPubSubTypes.h"
+#include "RenderQueue.hpp"
+#include "TerminalFrame.hpp"
+#include "BatchTake.hpp"
+#include "RingBuffer.hpp"
+#include "RollingStats.hpp"
 
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
 #include <fastdds/dds/domain/DomainParticipant.hpp>
@@ -10,8 +15,14 @@
 #include <fastdds/dds/subscriber/qos/DataReaderQos.hpp>
 #include <fastdds/dds/subscriber/SampleInfo.hpp>
 
-#include <deque>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
 #include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 #include <iomanip>
 #include <chrono>
 #include <thread>
@@ -19,73 +30,312 @@
 
 using namespace eprosima::fastdds::dds;
 
+// The fields shown in the history table
+struct SensorRow {
+    uint64_t timestamp;
+    uint32_t sequence_number;
+    float temperature;
+    float humidity;
+    float pressure;
+};
+
+// Struct-of-arrays history (--soa): one contiguous column per field and
+// no message string, so a pass over one field touches only that column.
+class SensorColumns {
+private:
+    std::vector<uint64_t> timestamp_;
+    std::vector<uint32_t> sequence_number_;
+    std::vector<float> temperature_;
+    std::vector<float> humidity_;
+    std::vector<float> pressure_;
+    size_t head_;
+    size_t size_;
+
+    size_t slot(size_t index) const {
+        return (head_ + capacity() - size_ + index) % capacity();
+    }
+
+public:
+    explicit SensorColumns(size_t capacity = 1)
+        : timestamp_(capacity > 0 ? capacity : 1)
+        , sequence_number_(timestamp_.size())
+        , temperature_(timestamp_.size())
+        , humidity_(timestamp_.size())
+        , pressure_(timestamp_.size())
+        , head_(0)
+        , size_(0) {
+    }
+
+    void push(const SensorData& data) {
+        timestamp_[head_] = data.timestamp();
+        sequence_number_[head_] = data.sequence_number();
+        temperature_[head_] = data.temperature();
+        humidity_[head_] = data.humidity();
+        pressure_[head_] = data.pressure();
+        head_ = (head_ + 1) % capacity();
+        if (size_ < capacity()) size_++;
+    }
+
+    SensorRow row(size_t index) const {
+        size_t i = slot(index);
+        SensorRow row = {timestamp_[i], sequence_number_[i], temperature_[i], humidity_[i], pressure_[i]};
+        return row;
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return temperature_.size(); }
+
+    // Keeps the newest min(size(), capacity) rows
+    void set_capacity(size_t capacity) {
+        if (capacity == 0) capacity = 1;
+        if (capacity == this->capacity()) return;
+
+        size_t keep = size_ < capacity ? size_ : capacity;
+        SensorColumns resized(capacity);
+        for (size_t i = 0; i < keep; ++i) {
+            SensorRow r = row(size_ - keep + i);
+            resized.timestamp_[i] = r.timestamp;
+            resized.sequence_number_[i] = r.sequence_number;
+            resized.temperature_[i] = r.temperature;
+            resized.humidity_[i] = r.humidity;
+            resized.pressure_[i] = r.pressure;
+        }
+        resized.head_ = keep % capacity;
+        resized.size_ = keep;
+        *this = std::move(resized);
+    }
+};
+
+// Rolling temperature/humidity/pressure statistics per sensor. A sensor is
+// one DataWriter (SampleInfo::publication_handle). Samples are added on the
+// receive thread, so samples the render queue drops are still counted, and
+// each sensor only keeps its window, not its history.
+class SensorStatsTable {
+public:
+    typedef RollingStats<3> Stats;
+
+    struct Summary {
+        uint32_t sensor;
+        size_t count;
+        double mean[3], stddev[3], min[3], max[3], p50[3], p95[3];
+    };
+
+private:
+    struct Sensor {
+        uint32_t number;
+        Stats stats;
+    };
+
+    size_t max_count_;
+    int64_t max_age_ns_;
+    std::map<InstanceHandle_t, Sensor> sensors_;
+    mutable std::mutex mutex_;
+
+    static std::array<Stats::Range, 3> ranges() {
+        // Temperature (°C), humidity (%), pressure (hPa), 0.25-1 unit buckets
+        std::array<Stats::Range, 3> ranges = {{{-40.0, 85.0}, {0.0, 100.0}, {900.0, 1100.0}}};
+        return ranges;
+    }
+
+public:
+    SensorStatsTable(size_t max_count, double max_age_s)
+        : max_count_(max_count)
+        , max_age_ns_(static_cast<int64_t>(max_age_s * 1e9)) {
+    }
+
+    size_t max_count() const { return max_count_; }
+    double max_age_s() const { return max_age_ns_ / 1e9; }
+
+    void add(const InstanceHandle_t& sensor, const SensorData& data) {
+        Stats::Values values = {{data.temperature(), data.humidity(), data.pressure()}};
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = sensors_.find(sensor);
+        if (it == sensors_.end()) {
+            Sensor entry = {static_cast<uint32_t>(sensors_.size() + 1),
+                            Stats(max_count_, max_age_ns_, ranges(), 400)};
+            it = sensors_.insert(std::make_pair(sensor, entry)).first;
+        }
+        it->second.stats.add(static_cast<int64_t>(data.timestamp()), values);
+    }
+
+    // Expires old samples and summarizes up to 'limit' sensors.
+    // Returns the total number of sensors.
+    size_t summarize(size_t limit, std::vector<Summary>& out) {
+        int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        out.clear();
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& pair : sensors_) {
+            Stats& stats = pair.second.stats;
+            stats.expire(now_ns);
+            if (out.size() >= limit) continue;
+
+            Summary summary;
+            summary.sensor = pair.second.number;
+            summary.count = stats.count();
+            for (size_t f = 0; f < 3; ++f) {
+                summary.mean[f] = stats.mean(f);
+                summary.stddev[f] = stats.stddev(f);
+                summary.min[f] = stats.min(f);
+                summary.max[f] = stats.max(f);
+                summary.p50[f] = stats.percentile(f, 50.0);
+                summary.p95[f] = stats.percentile(f, 95.0);
+            }
+            out.push_back(summary);
+        }
+        return sensors_.size();
+    }
+};
+
+// on_data_available() runs on the Fast DDS receive thread and only queues the
+// samples; render() keeps the history and prints it from the render thread.
 class HistoryListener : public DataReaderListener {
 private:
     std::string topic_name_;
-    std::deque<SensorData> history_;
-    std::mutex mutex_;
-    uint32_t total_samples_;
+    RenderQueue<SensorData> queue_;
     std::atomic<size_t> display_limit_;
+    int32_t max_batch_;
+    SensorStatsTable stats_;
+    std::vector<SensorStatsTable::Summary> summaries_;  // render thread
+    TerminalFrame frame_;
+
+    // Owned by the render thread. Only the displayed rows are kept: the
+    // capacity follows display_limit_ (row layout, or columns with --soa).
+    bool columnar_;
+    RingBuffer<SensorData> rows_;
+    SensorColumns columns_;
+    uint32_t total_samples_;
+
+    static SensorRow row_of(const SensorData& data) {
+        SensorRow row = {data.timestamp(), data.sequence_number(),
+                         data.temperature(), data.humidity(), data.pressure()};
+        return row;
+    }
+
+    size_t history_size() const {
+        return columnar_ ? columns_.size() : rows_.size();
+    }
 
 public:
-    HistoryListener(const std::string& topic_name)
+    HistoryListener(const std::string& topic_name, int32_t max_batch = kDefaultMaxBatch,
+                    bool columnar = false, size_t stats_count = 100, double stats_age_s = 60.0)
         : topic_name_(topic_name)
-        , total_samples_(0)
-        , display_limit_(5) {
+        , display_limit_(5)
+        , max_batch_(max_batch)
+        , stats_(stats_count, stats_age_s)
+        , columnar_(columnar)
+        , rows_(5)
+        , columns_(5)
+        , total_samples_(0) {
     }
 
     void setDisplayLimit(size_t limit) {
         display_limit_ = limit;
     }
 
+    // Called by the input thread after printing to the terminal
+    void invalidateFrame() {
+        frame_.invalidate();
+    }
+
+    // Burst mode delivers many samples per callback; they are taken in batches
     void on_data_available(DataReader* reader) override {
+        take_batches<SensorData>(reader, max_batch_, [this](const SensorData& data, const SampleInfo& info) {
+            stats_.add(info.publication_handle, data);
+            queue_.push(data);
+        });
+    }
+
+    // Appends the queued samples to the history and redraws the changed lines once
+    void render() {
+        size_t limit = display_limit_;
+        if (columnar_) {
+            columns_.set_capacity(limit);
+        } else {
+            rows_.set_capacity(limit);
+        }
+
         SensorData data;
-        SampleInfo info;
-        std::lock_guard<std::mutex> lock(mutex_);
+        bool updated = false;
+        while (queue_.pop(data)) {
+            if (columnar_) {
+                columns_.push(data);
+            } else {
+                rows_.push(std::move(data));  // data gets the evicted row back
+            }
+            total_samples_++;
+            updated = true;
+        }
+        if (!updated && !frame_.invalidated()) return;
+
+        std::ostream& out = frame_.begin();
+
+        // Print topic info
+        out << "=== " << topic_name_ << " History ===\n"
+            << "Total samples received: " << total_samples_ << "\n"
+            << "Current history size: " << history_size()
+            << (columnar_ ? " (columns)" : " (rows)") << "\n"
+            << "Dropped before display: " << queue_.dropped() << "\n"
+            << "Display limit: " << display_limit_ << " samples\n\n";
+
+        // Print table header
+        out << std::setw(6) << "Seq" 
+            << std::setw(10) << "Temp(°C)"
+            << std::setw(10) << "Hum(%)"
+            << std::setw(12) << "Press(hPa)"
+            << "  Time\n";
+        out << std::string(50, '-') << "\n";
+
+        // The history holds at most display_limit_ samples
+        for (size_t i = 0; i < history_size(); ++i) {
+            SensorRow sample = columnar_ ? columns_.row(i) : row_of(rows_[i]);
+            auto timestamp = std::chrono::system_clock::time_point(
+                std::chrono::nanoseconds(sample.timestamp));
+            auto time_t = std::chrono::system_clock::to_time_t(timestamp);
+            
+            out << std::setw(6) << sample.sequence_number
+                << std::fixed << std::setprecision(1)
+                << std::setw(10) << sample.temperature
+                << std::setw(10) << sample.humidity
+                << std::setw(12) << sample.pressure
+                << "  " << std::put_time(std::localtime(&time_t), "%H:%M:%S")
+                << "\n";
+        }
+
+        print_statistics(out);
+        frame_.present();
+    }
+
+    void print_statistics(std::ostream& out) {
+        const size_t kMaxSensorsShown = 8;
+        size_t sensors = stats_.summarize(kMaxSensorsShown, summaries_);
+
+        out << "\n=== Rolling statistics (";
+        if (stats_.max_count() > 0) out << "last " << stats_.max_count() << " samples";
+        if (stats_.max_count() > 0 && stats_.max_age_s() > 0.0) out << ", ";
+        if (stats_.max_age_s() > 0.0) out << "last " << stats_.max_age_s() << " s";
+        out << "), " << sensors << " sensor(s) ===\n";
 
-        while (reader->take_next_sample(&data, &info) == ReturnCode_t::RETCODE_OK) {
-            if (info.valid_data) {
-                history_.push_back(data);
-                total_samples_++;
-
-                // Clear screen and move cursor to top
-                std::cout << "\033[2J\033[H";
-                
-                // Print topic info
-                std::cout << "=== " << topic_name_ << " History ===\n"
-                         << "Total samples received: " << total_samples_ << "\n"
-                         << "Current history size: " << history_.size() << "\n"
-                         << "Display limit: " << display_limit_ << " samples\n\n";
-
-                // Print table header
-                std::cout << std::setw(6) << "Seq" 
-                         << std::setw(10) << "Temp(°C)"
-                         << std::setw(10) << "Hum(%)"
-                         << std::setw(12) << "Press(hPa)"
-                         << "  Time\n";
-                std::cout << std::string(50, '-') << "\n";
-
-                // 현재 모드에 따라 적절한 수의 샘플만 표시
-                size_t start_idx = (history_.size() > display_limit_) ? 
-                    history_.size() - display_limit_ : 0;
-                
-                for (size_t i = start_idx; i < history_.size(); ++i) {
-                    const auto& sample = history_[i];
-                    auto timestamp = std::chrono::system_clock::time_point(
-                        std::chrono::nanoseconds(sample.timestamp()));
-                    auto time_t = std::chrono::system_clock::to_time_t(timestamp);
-                    
-                    std::cout << std::setw(6) << sample.sequence_number()
-                             << std::fixed << std::setprecision(1)
-                             << std::setw(10) << sample.temperature()
-                             << std::setw(10) << sample.humidity()
-                             << std::setw(12) << sample.pressure()
-                             << "  " << std::put_time(std::localtime(&time_t), "%H:%M:%S")
-                             << std::endl;
+        out << std::setw(8) << "Sensor" << std::setw(7) << "N" << std::setw(11) << "Field"
+            << std::setw(9) << "mean" << std::setw(8) << "std" << std::setw(9) << "min"
+            << std::setw(9) << "max" << std::setw(9) << "p50" << std::setw(9) << "p95" << "\n";
+        const char* fields[] = {"Temp(°C)", "Hum(%)", "Press(hPa)"};
+        for (const auto& summary : summaries_) {
+            for (size_t f = 0; f < 3; ++f) {
+                if (f == 0) {
+                    out << std::setw(7) << "#" << summary.sensor << std::setw(7) << summary.count;
+                } else {
+                    out << std::setw(8) << "" << std::setw(7) << "";
                 }
-                std::cout.flush();
+                out << std::setw(11) << fields[f] << std::fixed << std::setprecision(1)
+                    << std::setw(9) << summary.mean[f] << std::setw(8) << summary.stddev[f]
+                    << std::setw(9) << summary.min[f] << std::setw(9) << summary.max[f]
+                    << std::setw(9) << summary.p50[f] << std::setw(9) << summary.p95[f] << "\n";
             }
         }
+        if (sensors > summaries_.size()) {
+            out << "... " << sensors - summaries_.size() << " more sensor(s)\n";
+        }
     }
 };
 
@@ -98,6 +348,7 @@ private:
     TypeSupport type_;
     HistoryListener listener_;
     std::atomic<bool> running_;
+    RenderLoop render_loop_;
 
     void setupKeepLastReader() {
         if (reader_ != nullptr) {
@@ -113,6 +364,7 @@ private:
         reader_ = subscriber_->create_datareader(topic_, qos, &listener_);
         
         std::cout << "\nSwitched to KEEP_LAST mode (depth: 5)" << std::endl;
+        listener_.invalidateFrame();
     }
 
     void setupKeepAllReader() {
@@ -129,16 +381,17 @@ private:
         reader_ = subscriber_->create_datareader(topic_, qos, &listener_);
         
         std::cout << "\nSwitched to KEEP_ALL mode (max samples: 30)" << std::endl;
+        listener_.invalidateFrame();
     }
     
 public:
-    HistorySubscriber()
+    HistorySubscriber(int32_t max_batch, bool columnar, size_t stats_count, double stats_age_s)
         : participant_(nullptr)
         , subscriber_(nullptr)
         , topic_(nullptr)
         , reader_(nullptr)
         , type_(new SensorDataPubSubType())
-        , listener_("History QoS Test")
+        , listener_("History QoS Test", max_batch, columnar, stats_count, stats_age_s)
         , running_(true) {
     }
 
@@ -190,6 +443,8 @@ public:
             setupKeepAllReader();
         }
 
+        render_loop_.start([this]() { listener_.render(); });
+
         // 사용자 입력을 처리하는 스레드
         std::thread input_thread([this]() {
             std::cout << "\nSubscriber is running.\n"
@@ -197,6 +452,7 @@ public:
                       << "1: Switch to KEEP_LAST mode\n"
                       << "2: Switch to KEEP_ALL mode\n"
                       << "q: Quit\n" << std::endl;
+            listener_.invalidateFrame();
 
             char cmd;
             while (running_) {
@@ -223,12 +479,32 @@ public:
         if (input_thread.joinable()) {
             input_thread.join();
         }
+        render_loop_.stop();
     }
 };
 
 int main(int argc, char** argv) {
     try {
-        HistorySubscriber subscriber;
+        // --soa: keep the history as columns instead of SensorData rows
+        // --stats-count <n> / --stats-age <s>: rolling statistics window (100 samples, 60 s; 0 = no limit)
+        bool columnar = false;
+        size_t stats_count = 100;
+        double stats_age_s = 60.0;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--soa") {
+                columnar = true;
+            } else if (arg == "--stats-count" && i + 1 < argc) {
+                stats_count = static_cast<size_t>(std::atol(argv[++i]));
+            } else if (arg == "--stats-age" && i + 1 < argc) {
+                stats_age_s = std::atof(argv[++i]);
+            }
+        }
+        if (stats_count == 0 && stats_age_s <= 0.0) {
+            stats_count = 100;  // the window needs at least one bound
+        }
+
+        HistorySubscriber subscriber(parse_max_batch(argc, argv), columnar, stats_count, stats_age_s);
         if (subscriber.init()) {
             subscriber.run();
         }
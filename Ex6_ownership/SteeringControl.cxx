@@ -151,7 +151,7 @@ uint64_t& SteeringCommand::timestamp()
  * @param _controller_name New value to be copied in member controller_name
  */
 void SteeringCommand::controller_name(
-        const std::string& _controller_name)
+        const eprosima::fastcdr::fixed_string<32>& _controller_name)
 {
     m_controller_name = _controller_name;
 }
@@ -161,7 +161,7 @@ void SteeringCommand::controller_name(
  * @param _controller_name New value to be moved in member controller_name
  */
 void SteeringCommand::controller_name(
-        std::string&& _controller_name)
+        eprosima::fastcdr::fixed_string<32>&& _controller_name)
 {
     m_controller_name = std::move(_controller_name);
 }
@@ -170,7 +170,7 @@ void SteeringCommand::controller_name(
  * @brief This function returns a constant reference to member controller_name
  * @return Constant reference to member controller_name
  */
-const std::string& SteeringCommand::controller_name() const
+const eprosima::fastcdr::fixed_string<32>& SteeringCommand::controller_name() const
 {
     return m_controller_name;
 }
@@ -179,7 +179,7 @@ const std::string& SteeringCommand::controller_name() const
  * @brief This function returns a reference to member controller_name
  * @return Reference to member controller_name
  */
-std::string& SteeringCommand::controller_name()
+eprosima::fastcdr::fixed_string<32>& SteeringCommand::controller_name()
 {
     return m_controller_name;
 }
@@ -277,7 +277,7 @@ float& SteeringCommand::vehicle_speed()
  * @param _control_reason New value to be copied in member control_reason
  */
 void SteeringCommand::control_reason(
-        const std::string& _control_reason)
+        const eprosima::fastcdr::fixed_string<64>& _control_reason)
 {
     m_control_reason = _control_reason;
 }
@@ -287,7 +287,7 @@ void SteeringCommand::control_reason(
  * @param _control_reason New value to be moved in member control_reason
  */
 void SteeringCommand::control_reason(
-        std::string&& _control_reason)
+        eprosima::fastcdr::fixed_string<64>&& _control_reason)
 {
     m_control_reason = std::move(_control_reason);
 }
@@ -296,7 +296,7 @@ void SteeringCommand::control_reason(
  * @brief This function returns a constant reference to member control_reason
  * @return Constant reference to member control_reason
  */
-const std::string& SteeringCommand::control_reason() const
+const eprosima::fastcdr::fixed_string<64>& SteeringCommand::control_reason() const
 {
     return m_control_reason;
 }
@@ -305,7 +305,7 @@ const std::string& SteeringCommand::control_reason() const
  * @brief This function returns a reference to member control_reason
  * @return Reference to member control_reason
  */
-std::string& SteeringCommand::control_reason()
+eprosima::fastcdr::fixed_string<64>& SteeringCommand::control_reason()
 {
     return m_control_reason;
 }
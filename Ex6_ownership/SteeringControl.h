@@ -155,26 +155,26 @@ public:
      * @param _controller_name New value to be copied in member controller_name
      */
     eProsima_user_DllExport void controller_name(
-            const std::string& _controller_name);
+            const eprosima::fastcdr::fixed_string<32>& _controller_name);
 
     /*!
      * @brief This function moves the value in member controller_name
      * @param _controller_name New value to be moved in member controller_name
      */
     eProsima_user_DllExport void controller_name(
-            std::string&& _controller_name);
+            eprosima::fastcdr::fixed_string<32>&& _controller_name);
 
     /*!
      * @brief This function returns a constant reference to member controller_name
      * @return Constant reference to member controller_name
      */
-    eProsima_user_DllExport const std::string& controller_name() const;
+    eProsima_user_DllExport const eprosima::fastcdr::fixed_string<32>& controller_name() const;
 
     /*!
      * @brief This function returns a reference to member controller_name
      * @return Reference to member controller_name
      */
-    eProsima_user_DllExport std::string& controller_name();
+    eProsima_user_DllExport eprosima::fastcdr::fixed_string<32>& controller_name();
 
 
     /*!
@@ -242,26 +242,26 @@ public:
      * @param _control_reason New value to be copied in member control_reason
      */
     eProsima_user_DllExport void control_reason(
-            const std::string& _control_reason);
+            const eprosima::fastcdr::fixed_string<64>& _control_reason);
 
     /*!
      * @brief This function moves the value in member control_reason
      * @param _control_reason New value to be moved in member control_reason
      */
     eProsima_user_DllExport void control_reason(
-            std::string&& _control_reason);
+            eprosima::fastcdr::fixed_string<64>&& _control_reason);
 
     /*!
      * @brief This function returns a constant reference to member control_reason
      * @return Constant reference to member control_reason
      */
-    eProsima_user_DllExport const std::string& control_reason() const;
+    eProsima_user_DllExport const eprosima::fastcdr::fixed_string<64>& control_reason() const;
 
     /*!
      * @brief This function returns a reference to member control_reason
      * @return Reference to member control_reason
      */
-    eProsima_user_DllExport std::string& control_reason();
+    eProsima_user_DllExport eprosima::fastcdr::fixed_string<64>& control_reason();
 
 
     /*!
@@ -286,11 +286,11 @@ public:
 private:
 
     uint64_t m_timestamp{0};
-    std::string m_controller_name;
+    eprosima::fastcdr::fixed_string<32> m_controller_name;
     float m_steering_angle{0.0};
     float m_steering_torque{0.0};
     float m_vehicle_speed{0.0};
-    std::string m_control_reason;
+    eprosima::fastcdr::fixed_string<64> m_control_reason;
     bool m_emergency_control{false};
 
 };
@@ -24,7 +24,7 @@
 
 #include "SteeringControl.h"
 
-constexpr uint32_t SteeringCommand_max_cdr_typesize {549UL};
+constexpr uint32_t SteeringCommand_max_cdr_typesize {138UL};
 constexpr uint32_t SteeringCommand_max_key_cdr_typesize {0UL};
 
 
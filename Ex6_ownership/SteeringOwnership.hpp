@@ -0,0 +1,119 @@
+#ifndef DDS_PRACTICE_EX6_STEERINGOWNERSHIP_HPP_
+#define DDS_PRACTICE_EX6_STEERINGOWNERSHIP_HPP_
+
+#include "RcuValue.hpp"
+
+#include <fastdds/rtps/common/InstanceHandle.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// A SteeringControl writer as the middleware reports it: the publication
+// handle samples carry in SampleInfo::publication_handle, the
+// OWNERSHIP_STRENGTH from the writer's discovered QoS and its liveliness.
+struct SteeringWriter {
+    eprosima::fastrtps::rtps::InstanceHandle_t handle;
+    uint32_t strength;
+    bool alive;
+};
+
+// Immutable once published (see SteeringOwnership). A handful of controllers:
+// linear searches over small vectors, no allocation or string compare per sample.
+struct SteeringOwnershipState {
+    std::vector<SteeringWriter> writers;
+    std::vector<uint32_t> enabled;  // strengths the dashboard shows
+
+    const SteeringWriter* find(const eprosima::fastrtps::rtps::InstanceHandle_t& handle) const {
+        for (const SteeringWriter& writer : writers) {
+            if (writer.handle == handle) return &writer;
+        }
+        return nullptr;
+    }
+
+    bool is_enabled(uint32_t strength) const {
+        return std::find(enabled.begin(), enabled.end(), strength) != enabled.end();
+    }
+
+    // With EXCLUSIVE ownership the strongest alive writer owns the instance
+    // (ties are broken by the middleware on the GUID)
+    const SteeringWriter* owner() const {
+        const SteeringWriter* owner = nullptr;
+        for (const SteeringWriter& writer : writers) {
+            if (writer.alive && (owner == nullptr || writer.strength > owner->strength)) {
+                owner = &writer;
+            }
+        }
+        return owner;
+    }
+};
+
+// Ownership table of the steering subscriber. Discovery and liveliness
+// callbacks (Fast DDS threads) and controller toggles (input thread) publish
+// new versions; on_data_available() and the render thread read lock-free
+// snapshots.
+class SteeringOwnership {
+public:
+    typedef RcuValue<SteeringOwnershipState>::Snapshot Snapshot;
+
+private:
+    RcuValue<SteeringOwnershipState> state_;
+
+    static SteeringWriter* find_writer(SteeringOwnershipState& state,
+                                       const eprosima::fastrtps::rtps::InstanceHandle_t& handle) {
+        for (SteeringWriter& writer : state.writers) {
+            if (writer.handle == handle) return &writer;
+        }
+        return nullptr;
+    }
+
+public:
+    Snapshot load() const { return state_.load(); }
+
+    // Discovered or QoS changed: a matched writer is alive until its
+    // liveliness says otherwise
+    void writer_discovered(const eprosima::fastrtps::rtps::InstanceHandle_t& handle, uint32_t strength) {
+        state_.update([&](SteeringOwnershipState& state) {
+            SteeringWriter* writer = find_writer(state, handle);
+            if (writer != nullptr) {
+                writer->strength = strength;
+            } else {
+                state.writers.push_back(SteeringWriter{handle, strength, true});
+            }
+        });
+    }
+
+    void writer_removed(const eprosima::fastrtps::rtps::InstanceHandle_t& handle) {
+        state_.update([&](SteeringOwnershipState& state) {
+            state.writers.erase(
+                std::remove_if(state.writers.begin(), state.writers.end(),
+                               [&](const SteeringWriter& writer) { return writer.handle == handle; }),
+                state.writers.end());
+        });
+    }
+
+    void set_alive(const eprosima::fastrtps::rtps::InstanceHandle_t& handle, bool alive) {
+        state_.update([&](SteeringOwnershipState& state) {
+            SteeringWriter* writer = find_writer(state, handle);
+            if (writer != nullptr) writer->alive = alive;
+        });
+    }
+
+    // Returns true if the strength is shown after the toggle
+    bool toggle(uint32_t strength) {
+        bool enabled = false;
+        state_.update([&](SteeringOwnershipState& state) {
+            auto it = std::find(state.enabled.begin(), state.enabled.end(), strength);
+            if (it != state.enabled.end()) {
+                state.enabled.erase(it);
+            } else {
+                state.enabled.push_back(strength);
+                std::sort(state.enabled.begin(), state.enabled.end());
+                enabled = true;
+            }
+        });
+        return enabled;
+    }
+};
+
+#endif  // DDS_PRACTICE_EX6_STEERINGOWNERSHIP_HPP_
@@ -1,5 +1,7 @@
 #include "SteeringControl.h"
 #include "SteeringControlPubSubTypes.h"
+#include "SteeringQos.hpp"
+#include "PeriodicScheduler.hpp"
 
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
 #include <fastdds/dds/domain/DomainParticipant.hpp>
@@ -35,13 +37,14 @@ private:
     std::atomic<bool> running_;
     ControllerType controller_type_;
     uint32_t ownership_strength_;
+    SteeringTiming timing_;
     std::random_device rd_;
     std::mt19937 gen_;
     std::uniform_real_distribution<> angle_dist_;
     std::uniform_real_distribution<> speed_dist_;
 
 public:
-    SteeringPublisher(ControllerType type)
+    SteeringPublisher(ControllerType type, const SteeringTiming& timing = SteeringTiming())
         : participant_(nullptr)
         , publisher_(nullptr)
         , topic_(nullptr)
@@ -49,6 +52,7 @@ public:
         , type_(new SteeringCommandPubSubType())
         , running_(true)
         , controller_type_(type)
+        , timing_(timing)
         , gen_(rd_())
         , angle_dist_(-30.0, 30.0)     // ±30도 범위
         , speed_dist_(0.0, 120.0) {    // 0~120 km/h
@@ -73,7 +77,7 @@ public:
     bool init() {
         // Participant 설정
         DomainParticipantQos participantQos;
-        participantQos.name("Steering_Publisher_" + command_.controller_name());
+        participantQos.name("Steering_Publisher_" + command_.controller_name().to_string());
         participant_ = DomainParticipantFactory::get_instance()->create_participant(0, participantQos);
         if (participant_ == nullptr) return false;
 
@@ -96,6 +100,7 @@ public:
         writerQos.reliability().kind = RELIABLE_RELIABILITY_QOS;
         writerQos.ownership().kind = EXCLUSIVE_OWNERSHIP_QOS;
         writerQos.ownership_strength().value = ownership_strength_;
+        apply_steering_timing(writerQos, timing_);
 
         writer_ = publisher_->create_datawriter(topic_, writerQos);
         if (writer_ == nullptr) return false;
@@ -133,22 +138,25 @@ public:
         auto time_t = std::chrono::system_clock::to_time_t(now);
         
         std::cout << std::put_time(std::localtime(&time_t), "%H:%M:%S") 
-                  << " [" << command_.controller_name() << "] Published:"
+                  << " [" << command_.controller_name().c_str() << "] Published:"
                   << " Angle=" << std::fixed << std::setprecision(1) 
                   << command_.steering_angle() << "°"
                   << " Speed=" << command_.vehicle_speed() << "km/h"
-                  << " Reason: " << command_.control_reason()
+                  << " Reason: " << command_.control_reason().c_str()
                   << " (Strength: " << ownership_strength_ << ")"
                   << std::endl;
     }
 
     void run() {
-        std::cout << "Publisher started: " << command_.controller_name() << "\n"
+        std::cout << "Publisher started: " << command_.controller_name().c_str() << "\n"
+                  << "Liveliness: " << liveliness_kind_name(timing_.liveliness)
+                  << ", lease " << timing_.lease_ms << " ms, deadline " << timing_.deadline_ms << " ms\n"
                   << "Press Ctrl+C to stop." << std::endl;
 
+        PeriodicTimer timer(std::chrono::milliseconds(100));
         while (running_) {
             publish();
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            timer.wait();
         }
     }
 
@@ -165,11 +173,17 @@ void signal_handler(int signum) {
 int main(int argc, char** argv) {
     signal(SIGINT, signal_handler);
 
-    if (argc != 2) {
-        std::cout << "Usage: " << argv[0] << " <controller_type>\n"
+    SteeringTiming timing;
+    bool valid = argc >= 2;
+    for (int i = 2; valid && i < argc; ++i) {
+        valid = parse_steering_timing_arg(argc, argv, i, timing);
+    }
+    if (!valid) {
+        std::cout << "Usage: " << argv[0] << " <controller_type> [options]\n"
                   << "  1: Manual Steering\n"
                   << "  2: ADAS Controller\n"
-                  << "  3: Emergency Controller\n";
+                  << "  3: Emergency Controller\n"
+                  << steering_timing_usage();
         return 1;
     }
 
@@ -184,7 +198,7 @@ int main(int argc, char** argv) {
     }
 
     try {
-        SteeringPublisher publisher(type);
+        SteeringPublisher publisher(type, timing);
         if (publisher.init()) {
             publisher.run();
         }
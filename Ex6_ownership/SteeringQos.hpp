@@ -0,0 +1,98 @@
+#ifndef DDS_PRACTICE_EX6_STEERINGQOS_HPP_
+#define DDS_PRACTICE_EX6_STEERINGQOS_HPP_
+
+#include <fastdds/dds/publisher/qos/DataWriterQos.hpp>
+#include <fastdds/dds/subscriber/qos/DataReaderQos.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+// Liveliness and deadline of the SteeringControl topic. With EXCLUSIVE
+// ownership the reader moves to the next strongest writer once the owner
+// loses liveliness, so the lease bounds how long a dead controller keeps
+// the steering: AUTOMATIC detects a dead process (the participant stops
+// announcing), MANUAL_BY_TOPIC also a hung controller (every write asserts
+// liveliness, so the writer has to write within each lease). The deadline
+// reports an owner that is alive but stopped sending commands.
+//
+// Writer and reader must be compatible: the reader's kind no stronger than
+// the writer's, its lease and deadline no shorter. The same options on
+// both sides always match.
+struct SteeringTiming {
+    eprosima::fastdds::dds::LivelinessQosPolicyKind liveliness;
+    uint32_t lease_ms;     // 0 = infinite
+    uint32_t deadline_ms;  // 0 = none
+
+    // Five and three periods of the 10 Hz controllers
+    SteeringTiming()
+        : liveliness(eprosima::fastdds::dds::AUTOMATIC_LIVELINESS_QOS)
+        , lease_ms(500)
+        , deadline_ms(300) {}
+};
+
+inline eprosima::fastrtps::Duration_t steering_duration(uint32_t ms) {
+    return eprosima::fastrtps::Duration_t(static_cast<int32_t>(ms / 1000), (ms % 1000) * 1000000u);
+}
+
+inline const char* liveliness_kind_name(eprosima::fastdds::dds::LivelinessQosPolicyKind kind) {
+    switch (kind) {
+        case eprosima::fastdds::dds::AUTOMATIC_LIVELINESS_QOS: return "automatic";
+        case eprosima::fastdds::dds::MANUAL_BY_PARTICIPANT_LIVELINESS_QOS: return "manual_by_participant";
+        case eprosima::fastdds::dds::MANUAL_BY_TOPIC_LIVELINESS_QOS: return "manual";
+    }
+    return "unknown";
+}
+
+inline void apply_steering_timing(eprosima::fastdds::dds::DataWriterQos& qos, const SteeringTiming& timing) {
+    qos.liveliness().kind = timing.liveliness;
+    if (timing.lease_ms > 0) {
+        qos.liveliness().lease_duration = steering_duration(timing.lease_ms);
+        // AUTOMATIC liveliness is asserted by these announcements, so a few
+        // of them fit in every lease
+        qos.liveliness().announcement_period = steering_duration(timing.lease_ms / 4 > 0 ? timing.lease_ms / 4 : 1);
+    }
+    if (timing.deadline_ms > 0) {
+        qos.deadline().period = steering_duration(timing.deadline_ms);
+    }
+}
+
+inline void apply_steering_timing(eprosima::fastdds::dds::DataReaderQos& qos, const SteeringTiming& timing) {
+    qos.liveliness().kind = timing.liveliness;
+    if (timing.lease_ms > 0) {
+        qos.liveliness().lease_duration = steering_duration(timing.lease_ms);
+    }
+    if (timing.deadline_ms > 0) {
+        qos.deadline().period = steering_duration(timing.deadline_ms);
+    }
+}
+
+// Parses the timing option at argv[i]; advances i past its value.
+// Returns false if argv[i] is not a timing option or its value is invalid.
+inline bool parse_steering_timing_arg(int argc, char** argv, int& i, SteeringTiming& timing) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) return false;
+
+    if (arg == "--liveliness") {
+        std::string value = argv[++i];
+        if (value == "automatic") timing.liveliness = eprosima::fastdds::dds::AUTOMATIC_LIVELINESS_QOS;
+        else if (value == "manual") timing.liveliness = eprosima::fastdds::dds::MANUAL_BY_TOPIC_LIVELINESS_QOS;
+        else return false;
+    } else if (arg == "--lease") {
+        timing.lease_ms = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--deadline") {
+        timing.deadline_ms = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+inline const char* steering_timing_usage() {
+    return "  --liveliness <automatic|manual> : AUTOMATIC or MANUAL_BY_TOPIC liveliness (default automatic)\n"
+           "  --lease <ms>                    : Liveliness lease duration (default 500, 0 = infinite);\n"
+           "                                    with manual, longer than the publish period\n"
+           "  --deadline <ms>                 : Deadline period (default 300, 0 = none)\n";
+}
+
+#endif  // DDS_PRACTICE_EX6_STEERINGQOS_HPP_
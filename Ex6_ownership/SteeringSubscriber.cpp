@@ -1,8 +1,14 @@
 #include "SteeringControl.h"
 #include "SteeringControlPubSubTypes.h"
+#include "SteeringQos.hpp"
+#include "SteeringOwnership.hpp"
+#include "RenderQueue.hpp"
+#include "BatchTake.hpp"
+#include "LatencyHistogram.hpp"
 
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
 #include <fastdds/dds/domain/DomainParticipant.hpp>
+#include <fastdds/dds/domain/DomainParticipantListener.hpp>
 #include <fastdds/dds/topic/TypeSupport.hpp>
 #include <fastdds/dds/subscriber/Subscriber.hpp>
 #include <fastdds/dds/subscriber/DataReader.hpp>
@@ -17,98 +23,305 @@
 #include <mutex>
 #include <atomic>
 #include <memory>
-#include <set>
+#include <algorithm>
+#include <vector>
+#include <map>
+#include <sstream>
+#include <cstdlib>
 
 using namespace eprosima::fastdds::dds;
 
 static std::mutex print_mutex;
 
+// Keeps the ownership table in step with discovery: every SteeringControl
+// writer is entered with the OWNERSHIP_STRENGTH of its QoS under the handle
+// its samples carry, and removed when it leaves. (Fast DDS 2.x does not
+// implement DataReader::get_matched_publication_data(), so the writer's QoS
+// is taken from the discovery data itself.)
+class SteeringDiscoveryListener : public DomainParticipantListener {
+private:
+    SteeringOwnership& ownership_;
+
+public:
+    explicit SteeringDiscoveryListener(SteeringOwnership& ownership) : ownership_(ownership) {}
+
+    void on_publisher_discovery(DomainParticipant*,
+                                eprosima::fastrtps::rtps::WriterDiscoveryInfo&& info) override {
+        typedef eprosima::fastrtps::rtps::WriterDiscoveryInfo Info;
+        if (info.info.topicName().to_string() != "SteeringControl") return;
+
+        InstanceHandle_t handle(info.info.guid());
+        switch (info.status) {
+            case Info::DISCOVERED_WRITER:
+            case Info::CHANGED_QOS_WRITER:
+                ownership_.writer_discovered(handle, info.info.m_qos.m_ownershipStrength.value);
+                break;
+            case Info::REMOVED_WRITER:
+            case Info::DROPPED_WRITER:
+                ownership_.writer_removed(handle);
+                break;
+            default:
+                break;
+        }
+    }
+};
+
+// A command with the strength of the writer that sent it and its
+// source -> reception latency (-1: not measurable)
+struct OwnedCommand {
+    SteeringCommand command;
+    uint32_t strength;
+    int64_t latency_ns;
+};
+
+// End-to-end latency of the steering commands: SampleInfo source timestamp
+// (the writer's clock) to reception timestamp (ours), so across hosts it
+// includes the clock offset. With EXCLUSIVE ownership only the owner's
+// samples are delivered, so a controller's histogram covers the time it
+// held the steering.
+struct SteeringLatencyOptions {
+    uint32_t stale_budget_ms;  // older commands are flagged as stale (0 = no guard)
+    uint32_t report_period_s;  // latency report interval (0 = no report)
+
+    // Half a period of the 10 Hz controllers
+    SteeringLatencyOptions() : stale_budget_ms(50), report_period_s(5) {}
+};
+
+// Latency of one controller in the current report interval
+struct ControllerLatency {
+    LatencyHistogram latency;
+    uint64_t stale;
+
+    ControllerLatency() : stale(0) {}
+};
+
+// on_data_available() runs on the Fast DDS receive thread: it classifies each
+// sample by its publication handle against one snapshot of the ownership
+// table and queues the commands of enabled controllers; printing happens in
+// render() on the render thread.
 class SteeringListener : public DataReaderListener {
 private:
-    std::string controller_type_;
+    SteeringOwnership& ownership_;
+    RenderQueue<OwnedCommand> queue_;
+    OwnedCommand latest_;  // owned by the render thread
     int received_count_;
     std::mutex& print_mutex_;
-    std::set<uint32_t>& active_strengths_;  // 현재 active한 controller들의 strength set
-    uint32_t strength_;
+    int32_t max_batch_;
+
+    // Liveliness and deadline events, updated on the Fast DDS threads
+    std::atomic<int32_t> alive_writers_;
+    std::atomic<uint32_t> liveliness_lost_;  // writers that went not alive
+    std::atomic<uint32_t> deadline_missed_;
+    std::atomic<uint64_t> unknown_writer_;  // samples of writers not (yet) in the table
+    std::string status_shown_;  // render thread: status block of the last frame
+
+    // Latency per controller strength. The lock is taken once per batch by
+    // the receive thread and once per report by the render thread.
+    SteeringLatencyOptions latency_options_;
+    std::mutex latency_mutex_;
+    std::map<uint32_t, ControllerLatency> latency_;
+    std::atomic<uint64_t> stale_total_;
+    std::chrono::steady_clock::time_point next_report_;  // render thread
+    std::string report_;                                 // render thread: last latency report
+
+    bool is_stale(int64_t latency_ns) const {
+        return latency_options_.stale_budget_ms > 0 &&
+               latency_ns > static_cast<int64_t>(latency_options_.stale_budget_ms) * 1000000;
+    }
+
+    // Builds the report of the interval since the previous one and starts a new interval
+    std::string latency_report() {
+        std::map<uint32_t, ControllerLatency> window;
+        {
+            std::lock_guard<std::mutex> lock(latency_mutex_);
+            for (auto& pair : latency_) {
+                ControllerLatency& out = window[pair.first];
+                std::swap(out.latency, pair.second.latency);  // swaps the buckets, no copy
+                out.stale = pair.second.stale;
+                pair.second.latency.reset();
+                pair.second.stale = 0;
+            }
+        }
+
+        std::ostringstream report;
+        report << "=== Command latency, source -> reception (last "
+               << latency_options_.report_period_s << " s) ===\n";
+        report << std::fixed << std::setprecision(1);
+        for (auto it = window.rbegin(); it != window.rend(); ++it) {
+            const LatencyHistogram& latency = it->second.latency;
+            report << getControllerName(it->first) << " (Strength: " << it->first << "): ";
+            if (latency.count() == 0) {
+                report << "no commands\n";
+                continue;
+            }
+            report << latency.count() << " cmds, p50 " << latency.percentile(50.0) / 1000.0
+                   << " us, p99 " << latency.percentile(99.0) / 1000.0
+                   << " us, max " << latency.max() / 1000.0 << " us";
+            if (latency_options_.stale_budget_ms > 0) {
+                report << ", stale " << it->second.stale;
+            }
+            report << "\n";
+        }
+        return report.str();
+    }
+
+    std::string ownership_status(const SteeringOwnershipState& state) const {
+        std::vector<SteeringWriter> writers = state.writers;
+        std::sort(writers.begin(), writers.end(), [](const SteeringWriter& a, const SteeringWriter& b) {
+            return a.strength > b.strength;
+        });
+        const SteeringWriter* owner = state.owner();
+
+        std::string status = "=== Controllers (discovered) ===\n";
+        for (const SteeringWriter& writer : writers) {
+            status += getControllerName(writer.strength) + " (Strength: " + std::to_string(writer.strength) + "): " +
+                      (writer.alive ? "alive" : "NOT ALIVE") +
+                      (owner != nullptr && owner->handle == writer.handle ? ", owner" : "") +
+                      (state.is_enabled(writer.strength) ? "" : ", hidden") + "\n";
+        }
+        status += "\nWriters alive: " + std::to_string(alive_writers_.load()) +
+                  ", liveliness lost: " + std::to_string(liveliness_lost_.load()) +
+                  ", deadlines missed: " + std::to_string(deadline_missed_.load()) +
+                  ", unknown writer: " + std::to_string(unknown_writer_.load());
+        return status;
+    }
 
 public:
-    SteeringListener(const std::string& controller_type, std::mutex& mutex, 
-                    std::set<uint32_t>& active_strengths, uint32_t strength)
-        : controller_type_(controller_type)
+    SteeringListener(SteeringOwnership& ownership, std::mutex& mutex,
+                    int32_t max_batch = kDefaultMaxBatch,
+                    const SteeringLatencyOptions& latency_options = SteeringLatencyOptions())
+        : ownership_(ownership)
         , received_count_(0)
         , print_mutex_(mutex)
-        , active_strengths_(active_strengths)
-        , strength_(strength) {
+        , max_batch_(max_batch)
+        , alive_writers_(0)
+        , liveliness_lost_(0)
+        , deadline_missed_(0)
+        , unknown_writer_(0)
+        , latency_options_(latency_options)
+        , stale_total_(0)
+        , next_report_(std::chrono::steady_clock::now() + std::chrono::seconds(latency_options.report_period_s)) {
+        latest_.strength = 0;
+        latest_.latency_ns = -1;
+    }
+
+    // A writer that does not assert liveliness within its lease (dead process,
+    // or a hung controller with MANUAL_BY_TOPIC) loses the ownership here
+    void on_liveliness_changed(DataReader*, const LivelinessChangedStatus& status) override {
+        alive_writers_ = status.alive_count;
+        if (status.not_alive_count_change > 0) {
+            liveliness_lost_ += static_cast<uint32_t>(status.not_alive_count_change);
+            ownership_.set_alive(status.last_publication_handle, false);
+        } else if (status.alive_count_change > 0) {
+            ownership_.set_alive(status.last_publication_handle, true);
+        }
+    }
+
+    void on_requested_deadline_missed(DataReader*, const RequestedDeadlineMissedStatus& status) override {
+        deadline_missed_ = static_cast<uint32_t>(status.total_count);
     }
 
     void on_data_available(DataReader* reader) override {
-        SteeringCommand command;
-        SampleInfo info;
-        
-        while (reader->take_next_sample(&command, &info) == ReturnCode_t::RETCODE_OK) {
-            if (info.valid_data) {
-                // active_strengths가 비어있으면 데이터를 처리하지 않음
-                if (active_strengths_.empty()) {
-                    continue;
-                }
+        SteeringOwnership::Snapshot state = ownership_.load();
+        std::lock_guard<std::mutex> lock(latency_mutex_);
+        take_batches<SteeringCommand>(reader, max_batch_, [&](const SteeringCommand& command, const SampleInfo& info) {
+            const SteeringWriter* writer = state->find(info.publication_handle);
+            if (writer == nullptr) {
+                // Discovery has not reported the writer yet
+                unknown_writer_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
 
-                uint32_t controller_strength = getStrengthFromName(command.controller_name());
-                
-                // 현재 controller가 active 상태인지 확인
-                if (active_strengths_.count(controller_strength) > 0) {
-                    // active strength 중에서 현재 controller보다 높은 strength를 가진 것이 있는지 확인
-                    bool is_highest_active = true;
-                    for (auto strength : active_strengths_) {
-                        if (strength > controller_strength) {
-                            // 더 높은 strength가 있더라도, 해당 controller가 현재 publishing 중인지는 알 수 없음
-                            // 따라서 현재 들어온 데이터를 처리
-                            is_highest_active = true;
-                        }
-                    }
-
-                    if (is_highest_active) {
-                        std::lock_guard<std::mutex> lock(print_mutex_);
-                        received_count_++;
-
-                        auto timestamp = std::chrono::system_clock::time_point(
-                            std::chrono::nanoseconds(command.timestamp()));
-                        auto time_t = std::chrono::system_clock::to_time_t(timestamp);
-
-                        std::cout << "\033[2J\033[H";  // Clear screen
-
-                        std::cout << "=== Active Controllers ===\n";
-                        for (auto strength : active_strengths_) {
-                            std::cout << getControllerName(strength) << " (Strength: " << strength << ")\n";
-                        }
-                        std::cout << "\n";
-
-                        std::cout << "=== Current Controller (" << command.controller_name() 
-                                 << ", Strength: " << controller_strength << ") ===\n"
-                                << "Time: " << std::put_time(std::localtime(&time_t), "%H:%M:%S") << "\n"
-                                << "Steering Angle: " << std::fixed << std::setprecision(1) 
-                                << command.steering_angle() << "°\n"
-                                << "Vehicle Speed: " << command.vehicle_speed() << " km/h\n"
-                                << "Control Reason: " << command.control_reason() << "\n"
-                                << "Emergency Control: " << (command.emergency_control() ? "YES" : "No") << "\n"
-                                << "Total messages received: " << received_count_ << "\n\n";
-
-                        std::cout << "Enter command (1-3, s, q): ";
-                        std::cout.flush();
-                    }
+            // Recorded for every controller, shown or not
+            int64_t latency_ns = info.reception_timestamp.to_ns() - info.source_timestamp.to_ns();
+            if (latency_ns >= 0) {
+                ControllerLatency& latency = latency_[writer->strength];
+                latency.latency.record(static_cast<uint64_t>(latency_ns));
+                if (is_stale(latency_ns)) {
+                    latency.stale++;
+                    stale_total_.fetch_add(1, std::memory_order_relaxed);
                 }
+            } else {
+                latency_ns = -1;  // clocks of the hosts out of step
             }
-        }
+
+            if (!state->is_enabled(writer->strength)) return;
+            queue_.push(OwnedCommand{command, writer->strength, latency_ns});
+        });
     }
 
-private:
-    uint32_t getStrengthFromName(const std::string& controller_name) {
-        if (controller_name == "Manual Steering") return 10;
-        if (controller_name == "ADAS Controller") return 20;
-        if (controller_name == "Emergency Controller") return 30;
-        return 0;
+    // Called from the render thread: redraws the newest accepted command and
+    // the ownership table
+    void render() {
+        OwnedCommand owned;
+        bool updated = false;
+
+        while (queue_.pop(owned)) {
+            received_count_++;
+            latest_ = std::move(owned);
+            updated = true;
+        }
+        bool reported = false;
+        auto now = std::chrono::steady_clock::now();
+        if (latency_options_.report_period_s > 0 && now >= next_report_) {
+            next_report_ = now + std::chrono::seconds(latency_options_.report_period_s);
+            report_ = latency_report();
+            reported = true;
+        }
+
+        // Ownership and liveliness changes are shown even when no command arrives.
+        // The snapshot is not held while printing.
+        std::string status;
+        std::vector<uint32_t> enabled;
+        {
+            SteeringOwnership::Snapshot state = ownership_.load();
+            status = ownership_status(*state);
+            enabled = state->enabled;
+        }
+        if (!updated && !reported && status == status_shown_) return;
+        status_shown_ = status;
+
+        const SteeringCommand& command = latest_.command;
+        auto timestamp = std::chrono::system_clock::time_point(
+            std::chrono::nanoseconds(command.timestamp()));
+        auto time_t = std::chrono::system_clock::to_time_t(timestamp);
+
+        std::lock_guard<std::mutex> lock(print_mutex_);
+        std::cout << "\033[2J\033[H";  // Clear screen
+
+        std::cout << "=== Active Controllers ===\n";
+        for (auto strength : enabled) {
+            std::cout << getControllerName(strength) << " (Strength: " << strength << ")\n";
+        }
+        std::cout << "\n" << status << "\n\n";
+        if (!report_.empty()) {
+            std::cout << report_ << "\n";
+        }
+
+        if (received_count_ > 0) {
+            std::cout << "=== Current Controller (" << command.controller_name().c_str()
+                     << ", Strength: " << latest_.strength << ") ===\n"
+                    << "Time: " << std::put_time(std::localtime(&time_t), "%H:%M:%S") << "\n"
+                    << "Steering Angle: " << std::fixed << std::setprecision(1) 
+                    << command.steering_angle() << "°\n"
+                    << "Vehicle Speed: " << command.vehicle_speed() << " km/h\n"
+                    << "Control Reason: " << command.control_reason().c_str() << "\n"
+                    << "Emergency Control: " << (command.emergency_control() ? "YES" : "No") << "\n";
+            if (latest_.latency_ns >= 0) {
+                std::cout << "Latency: " << std::setprecision(2) << latest_.latency_ns / 1e6 << " ms"
+                          << (is_stale(latest_.latency_ns) ? "  ** STALE (budget " +
+                              std::to_string(latency_options_.stale_budget_ms) + " ms) **" : "") << "\n";
+            }
+            std::cout << "Total messages received: " << received_count_
+                    << " (dropped before display: " << queue_.dropped() << ")\n"
+                    << "Stale commands: " << stale_total_.load() << "\n\n";
+        }
+
+        std::cout << "Enter command (1-3, s, q): ";
+        std::cout.flush();
     }
 
-    std::string getControllerName(uint32_t strength) {
+    static std::string getControllerName(uint32_t strength) {
         switch (strength) {
             case 10: return "Manual Control";
             case 20: return "ADAS Control";
@@ -127,41 +340,49 @@ private:
     TypeSupport type_;
     std::unique_ptr<SteeringListener> listener_;
     std::atomic<bool> running_;
-    std::set<uint32_t> active_strengths_;  // 현재 active한 controller들의 strength set
+    RenderLoop render_loop_;
+    int32_t max_batch_;
+    SteeringTiming timing_;
+    SteeringLatencyOptions latency_options_;
+    SteeringOwnership ownership_;  // discovered writers와 active한 controller들의 strength
+    SteeringDiscoveryListener discovery_listener_;
 
     struct ControllerInfo {
         std::string type;
-        bool active;
         uint32_t strength;
 
         ControllerInfo(const std::string& t = "", uint32_t s = 0)
-            : type(t), active(false), strength(s) {}
+            : type(t), strength(s) {}
     };
     std::map<int, ControllerInfo> controllers_;
 
+    // Publishes a new table version; the listener picks it up with its next batch
     void toggleController(int id) {
-        auto& info = controllers_[id];
-        info.active = !info.active;
+        const auto& info = controllers_[id];
 
-        if (info.active) {
-            active_strengths_.insert(info.strength);
+        if (ownership_.toggle(info.strength)) {
             std::cout << "\nEnabled " << info.type 
                      << " (Strength: " << info.strength << ")" << std::endl;
         } else {
-            active_strengths_.erase(info.strength);
             std::cout << "\nDisabled " << info.type 
                      << " (Strength: " << info.strength << ")" << std::endl;
         }
     }
 
 public:
-    SteeringSubscriber()
+    explicit SteeringSubscriber(int32_t max_batch = kDefaultMaxBatch,
+                                const SteeringTiming& timing = SteeringTiming(),
+                                const SteeringLatencyOptions& latency_options = SteeringLatencyOptions())
         : participant_(nullptr)
         , subscriber_(nullptr)
         , topic_(nullptr)
         , reader_(nullptr)
         , type_(new SteeringCommandPubSubType())
-        , running_(true) {
+        , running_(true)
+        , max_batch_(max_batch)
+        , timing_(timing)
+        , latency_options_(latency_options)
+        , discovery_listener_(ownership_) {
         
         // 컨트롤러 정보 초기화
         controllers_[1] = ControllerInfo("Manual Control", 10);
@@ -187,7 +408,8 @@ public:
     bool init() {
         DomainParticipantQos participantQos;
         participantQos.name("Steering_Subscriber");
-        participant_ = DomainParticipantFactory::get_instance()->create_participant(0, participantQos);
+        participant_ = DomainParticipantFactory::get_instance()->create_participant(
+            0, participantQos, &discovery_listener_, StatusMask::none());
         if (participant_ == nullptr) return false;
 
         type_.register_type(participant_);
@@ -204,12 +426,12 @@ public:
         DataReaderQos readerQos = DATAREADER_QOS_DEFAULT;
         readerQos.reliability().kind = RELIABLE_RELIABILITY_QOS;
         readerQos.ownership().kind = EXCLUSIVE_OWNERSHIP_QOS;
+        apply_steering_timing(readerQos, timing_);
 
         // 기본 Manual control은 active로 설정
-        active_strengths_.insert(controllers_[1].strength);
-        controllers_[1].active = true;
+        ownership_.toggle(controllers_[1].strength);
 
-        listener_.reset(new SteeringListener("SteeringControl", print_mutex, active_strengths_, 0));
+        listener_.reset(new SteeringListener(ownership_, print_mutex, max_batch_, latency_options_));
         reader_ = subscriber_->create_datareader(
             topic_,
             readerQos,
@@ -220,10 +442,11 @@ public:
     }
 
     void showStatus() {
+        SteeringOwnership::Snapshot state = ownership_.load();
         std::cout << "\nCurrent subscriptions:\n";
         for (const auto& pair : controllers_) {
             std::cout << pair.second.type << ": "
-                     << (pair.second.active ? "Active" : "Inactive")
+                     << (state->is_enabled(pair.second.strength) ? "Active" : "Inactive")
                      << " (Strength: " << pair.second.strength << ")"
                      << std::endl;
         }
@@ -239,6 +462,8 @@ public:
 
         showStatus();
 
+        render_loop_.start([this]() { listener_->render(); });
+
         std::thread input_thread([this]() {
             char cmd;
             while (running_) {
@@ -268,12 +493,35 @@ public:
         if (input_thread.joinable()) {
             input_thread.join();
         }
+        render_loop_.stop();
     }
 };
 
-int main() {
+int main(int argc, char** argv) {
+    SteeringTiming timing;
+    SteeringLatencyOptions latency_options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--max-batch" && i + 1 < argc) {
+            ++i;
+        } else if (arg == "--stale-budget" && i + 1 < argc) {
+            latency_options.stale_budget_ms = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--latency-report" && i + 1 < argc) {
+            latency_options.report_period_s = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (!parse_steering_timing_arg(argc, argv, i, timing)) {
+            std::cout << "Usage: " << argv[0] << " [options]\n"
+                      << "  --max-batch <n>                 : Samples taken per take() call (default 32)\n"
+                      << "  --stale-budget <ms>             : Flag commands older than this on reception\n"
+                      << "                                    (default 50, 0 = off)\n"
+                      << "  --latency-report <s>            : Per-controller latency report interval\n"
+                      << "                                    (default 5, 0 = off)\n"
+                      << steering_timing_usage();
+            return 1;
+        }
+    }
+
     try {
-        SteeringSubscriber subscriber;
+        SteeringSubscriber subscriber(parse_max_batch(argc, argv), timing, latency_options);
         if (subscriber.init()) {
             subscriber.run();
         }
@@ -0,0 +1,102 @@
+#ifndef DDS_PRACTICE_COMMON_ALLOCATIONCOUNTER_HPP_
+#define DDS_PRACTICE_COMMON_ALLOCATIONCOUNTER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// Counts heap allocations per thread by replacing the global operator new.
+// The replacement also sees the allocations made inside the Fast DDS and
+// Fast CDR libraries, so it measures the whole receive path.
+// The operators are defined here, so include this header from exactly one
+// translation unit of an executable (the examples' main .cpp).
+//
+// Every allocation of the process pays for the replacement, so it is only
+// compiled in with DDS_PRACTICE_COUNT_ALLOCATIONS (cmake -DCOUNT_ALLOCATIONS=ON).
+// Without it enabled() is false and nothing is counted.
+
+namespace alloc_counter {
+
+inline bool enabled() {
+#ifdef DDS_PRACTICE_COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+inline uint64_t& thread_count() {
+    static thread_local uint64_t count = 0;
+    return count;
+}
+
+// Allocations made so far by the calling thread
+inline uint64_t thread_allocations() {
+    return thread_count();
+}
+
+}  // namespace alloc_counter
+
+#ifdef DDS_PRACTICE_COUNT_ALLOCATIONS
+
+// Kept out of line so GCC does not pair the inlined malloc/free with new/delete
+// call sites (-Wmismatched-new-delete)
+#if defined(__GNUC__)
+#define ALLOC_COUNTER_NOINLINE __attribute__((noinline))
+#else
+#define ALLOC_COUNTER_NOINLINE
+#endif
+
+ALLOC_COUNTER_NOINLINE void* operator new(std::size_t size) {
+    alloc_counter::thread_count()++;
+    void* ptr = std::malloc(size != 0 ? size : 1);
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+ALLOC_COUNTER_NOINLINE void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+ALLOC_COUNTER_NOINLINE void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    alloc_counter::thread_count()++;
+    return std::malloc(size != 0 ? size : 1);
+}
+
+ALLOC_COUNTER_NOINLINE void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return ::operator new(size, tag);
+}
+
+ALLOC_COUNTER_NOINLINE void operator delete(void* ptr) noexcept { std::free(ptr); }
+ALLOC_COUNTER_NOINLINE void operator delete[](void* ptr) noexcept { std::free(ptr); }
+ALLOC_COUNTER_NOINLINE void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+ALLOC_COUNTER_NOINLINE void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+ALLOC_COUNTER_NOINLINE void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+ALLOC_COUNTER_NOINLINE void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+#endif  // DDS_PRACTICE_COUNT_ALLOCATIONS
+
+// Allocations counted on a receive path, and the samples they were spent on.
+// take_window() returns the counts since its previous call, so after warm-up
+// it shows the steady state.
+class AllocationStats {
+private:
+    std::atomic<uint64_t> allocations_;
+    std::atomic<uint64_t> samples_;
+
+public:
+    AllocationStats() : allocations_(0), samples_(0) {}
+
+    void add(uint64_t allocations, uint64_t samples) {
+        allocations_.fetch_add(allocations, std::memory_order_relaxed);
+        samples_.fetch_add(samples, std::memory_order_relaxed);
+    }
+
+    void take_window(uint64_t& allocations, uint64_t& samples) {
+        allocations = allocations_.exchange(0, std::memory_order_relaxed);
+        samples = samples_.exchange(0, std::memory_order_relaxed);
+    }
+};
+
+#endif  // DDS_PRACTICE_COMMON_ALLOCATIONCOUNTER_HPP_
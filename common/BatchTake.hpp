@@ -0,0 +1,53 @@
+#ifndef DDS_PRACTICE_COMMON_BATCHTAKE_HPP_
+#define DDS_PRACTICE_COMMON_BATCHTAKE_HPP_
+
+#include <fastdds/dds/core/LoanableSequence.hpp>
+#include <fastdds/dds/subscriber/DataReader.hpp>
+#include <fastdds/dds/subscriber/SampleInfo.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+// Default number of samples taken per DataReader::take() call
+const int32_t kDefaultMaxBatch = 32;
+
+// Drains the reader in batches of up to max_batch samples. Each take() loans
+// the samples from the reader instead of deserializing into a new object per
+// sample, so a burst costs one reader lock per batch. fn(sample, info) is
+// called for every valid sample; the loan is returned after each batch, so fn
+// must copy anything it keeps. The loaned objects come from the reader's sample
+// pool and are deserialized in place, reusing their string/vector capacity.
+// Returns the number of valid samples taken.
+template<typename T, typename Fn>
+inline size_t take_batches(eprosima::fastdds::dds::DataReader* reader, int32_t max_batch, Fn fn) {
+    using namespace eprosima::fastdds::dds;
+
+    LoanableSequence<T> samples;
+    SampleInfoSeq infos;
+    size_t taken = 0;
+    while (reader->take(samples, infos, max_batch) == ReturnCode_t::RETCODE_OK) {
+        for (LoanableCollection::size_type i = 0; i < samples.length(); ++i) {
+            if (infos[i].valid_data) {
+                fn(samples[i], infos[i]);
+                ++taken;
+            }
+        }
+        reader->return_loan(samples, infos);
+    }
+    return taken;
+}
+
+// Returns the value of "--max-batch <n>" if present, kDefaultMaxBatch otherwise
+inline int32_t parse_max_batch(int argc, char** argv) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--max-batch") {
+            int32_t value = static_cast<int32_t>(std::atoi(argv[i + 1]));
+            return value > 0 ? value : kDefaultMaxBatch;
+        }
+    }
+    return kDefaultMaxBatch;
+}
+
+#endif  // DDS_PRACTICE_COMMON_BATCHTAKE_HPP_
@@ -0,0 +1,102 @@
+#ifndef DDS_PRACTICE_COMMON_CHANGEFILTER_HPP_
+#define DDS_PRACTICE_COMMON_CHANGEFILTER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <string>
+
+// Dead-bands of float fields by name ("<topic>.<field>", e.g. "battery.voltage").
+// A field without an entry uses the default band (0: any change counts).
+class DeadBands {
+private:
+    std::map<std::string, double> bands_;
+    double default_;
+
+public:
+    DeadBands() : default_(0.0) {}
+
+    void set(const std::string& name, double band) { bands_[name] = band; }
+    void set_default(double band) { default_ = band; }
+
+    double get(const std::string& name) const {
+        auto it = bands_.find(name);
+        return it != bands_.end() ? it->second : default_;
+    }
+
+    // Parses "<name>=<band>"
+    bool parse(const std::string& spec) {
+        size_t sep = spec.find('=');
+        if (sep == std::string::npos || sep == 0) return false;
+        set(spec.substr(0, sep), std::atof(spec.c_str() + sep + 1));
+        return true;
+    }
+
+    static bool exceeds(double previous, double current, double band) {
+        return std::fabs(current - previous) > band;
+    }
+};
+
+// Change-only publishing: accept() lets a sample through when changed(last
+// sent, sample) reports a significant change, or when the heartbeat interval
+// has passed since the last accepted sample, so subscribers still see the
+// writer is alive and late joiners get the state. Comparing against the
+// last *sent* sample means slow drift is published once it adds up to more
+// than a dead-band. One filter per publishing thread; the counters can be
+// read from any thread.
+template<typename T>
+class ChangeFilter {
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::function<bool(const T& previous, const T& current)> ChangedFn;
+
+private:
+    ChangedFn changed_;
+    Clock::duration heartbeat_;  // zero: no heartbeat
+    T last_;
+    bool has_last_;
+    Clock::time_point last_sent_;
+    std::atomic<uint64_t> sent_;
+    std::atomic<uint64_t> suppressed_;
+    std::atomic<uint64_t> heartbeats_;
+
+public:
+    ChangeFilter(ChangedFn changed, Clock::duration heartbeat)
+        : changed_(changed)
+        , heartbeat_(heartbeat)
+        , has_last_(false)
+        , sent_(0)
+        , suppressed_(0)
+        , heartbeats_(0) {}
+
+    // Returns true if the sample should be written; it then becomes the
+    // reference for the next comparisons
+    bool accept(const T& sample, Clock::time_point now = Clock::now()) {
+        if (has_last_) {
+            bool due = heartbeat_ > Clock::duration::zero() && now - last_sent_ >= heartbeat_;
+            if (!changed_(last_, sample)) {
+                if (!due) {
+                    suppressed_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                heartbeats_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        last_ = sample;
+        has_last_ = true;
+        last_sent_ = now;
+        sent_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    Clock::duration heartbeat() const { return heartbeat_; }
+    uint64_t sent() const { return sent_.load(std::memory_order_relaxed); }
+    uint64_t suppressed() const { return suppressed_.load(std::memory_order_relaxed); }
+    uint64_t heartbeats() const { return heartbeats_.load(std::memory_order_relaxed); }
+};
+
+#endif  // DDS_PRACTICE_COMMON_CHANGEFILTER_HPP_
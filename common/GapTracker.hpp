@@ -0,0 +1,181 @@
+#ifndef DDS_PRACTICE_COMMON_GAPTRACKER_HPP_
+#define DDS_PRACTICE_COMMON_GAPTRACKER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Incremental sequence-number gap tracker over a sliding bitmap window.
+// Each received sequence updates the counters in O(1) (amortized: every
+// sequence number leaves the window once), and memory is one bit per
+// sequence in the window. A sequence still missing when it slides out of
+// the window is counted as lost; one arriving after that is counted as
+// too late, since it can no longer be told apart from a duplicate.
+class GapTracker {
+private:
+    std::vector<uint64_t> bits_;  // ring: bit (seq & mask_) is set when seq was received
+    uint64_t mask_;
+    bool started_;
+    uint64_t first_;    // first sequence seen
+    uint64_t base_;     // lowest sequence still in the window
+    uint64_t highest_;  // highest sequence received
+
+    uint64_t received_;   // unique sequences received
+    uint64_t missing_;    // missing sequences inside the window
+    uint64_t lost_;       // missing sequences that left the window
+    uint64_t gaps_;       // runs of missing sequences inside the window
+    uint64_t duplicates_;
+    uint64_t reordered_;  // arrived below the highest sequence
+    uint64_t max_reorder_depth_;
+    uint64_t too_late_;   // arrived below the window
+
+    static uint64_t round_up_pow2(uint64_t value) {
+        uint64_t result = 64;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+    bool test(uint64_t seq) const {
+        uint64_t bit = seq & mask_;
+        return (bits_[bit >> 6] >> (bit & 63)) & 1;
+    }
+
+    void set(uint64_t seq) {
+        uint64_t bit = seq & mask_;
+        bits_[bit >> 6] |= uint64_t(1) << (bit & 63);
+    }
+
+    void clear(uint64_t seq) {
+        uint64_t bit = seq & mask_;
+        bits_[bit >> 6] &= ~(uint64_t(1) << (bit & 63));
+    }
+
+    // Slides the window so it starts at new_base
+    void advance(uint64_t new_base) {
+        // Sequences up to highest_ are in the bitmap; at most one window of them
+        uint64_t end = new_base < highest_ + 1 ? new_base : highest_ + 1;
+        for (uint64_t seq = base_; seq < end; ++seq) {
+            if (test(seq)) {
+                clear(seq);
+                continue;
+            }
+            missing_--;
+            lost_++;
+            // The run ends here unless it continues past this sequence
+            if (test(seq + 1)) {
+                gaps_--;
+            }
+        }
+        // Never received and already below the new window
+        if (new_base > highest_ + 1) {
+            uint64_t from = base_ > highest_ + 1 ? base_ : highest_ + 1;
+            lost_ += new_base - from;
+        }
+        base_ = new_base;
+    }
+
+public:
+    explicit GapTracker(size_t window = 65536)
+        : bits_(round_up_pow2(window) / 64, 0)
+        , mask_(round_up_pow2(window) - 1) {
+        reset();
+    }
+
+    void reset() {
+        for (auto& word : bits_) word = 0;
+        started_ = false;
+        first_ = base_ = highest_ = 0;
+        received_ = missing_ = lost_ = gaps_ = 0;
+        duplicates_ = reordered_ = max_reorder_depth_ = too_late_ = 0;
+    }
+
+    void on_sequence(uint64_t seq) {
+        if (!started_) {
+            started_ = true;
+            first_ = base_ = highest_ = seq;
+            set(seq);
+            received_++;
+            return;
+        }
+
+        if (seq > highest_) {
+            if (seq - base_ > mask_) {
+                advance(seq - mask_);
+            }
+            uint64_t gap_start = highest_ + 1 > base_ ? highest_ + 1 : base_;
+            if (gap_start < seq) {
+                missing_ += seq - gap_start;
+                gaps_++;
+            }
+            set(seq);
+            highest_ = seq;
+            received_++;
+            return;
+        }
+
+        if (seq < base_) {
+            too_late_++;
+            return;
+        }
+        if (test(seq)) {
+            duplicates_++;
+            return;
+        }
+
+        // Fills a hole: splits, shrinks or closes its run
+        reordered_++;
+        if (highest_ - seq > max_reorder_depth_) {
+            max_reorder_depth_ = highest_ - seq;
+        }
+        bool left_missing = seq > base_ && !test(seq - 1);
+        bool right_missing = !test(seq + 1);  // seq < highest_, which is always set
+        if (left_missing && right_missing) {
+            gaps_++;
+        } else if (!left_missing && !right_missing) {
+            gaps_--;
+        }
+        set(seq);
+        missing_--;
+        received_++;
+    }
+
+    bool started() const { return started_; }
+    uint64_t window() const { return mask_ + 1; }
+    uint64_t highest() const { return highest_; }
+    uint64_t expected() const { return started_ ? highest_ - first_ + 1 : 0; }
+    uint64_t received() const { return received_; }
+    uint64_t missing() const { return missing_; }
+    uint64_t lost() const { return lost_; }
+    uint64_t gaps() const { return gaps_; }
+    uint64_t duplicates() const { return duplicates_; }
+    uint64_t reordered() const { return reordered_; }
+    uint64_t max_reorder_depth() const { return max_reorder_depth_; }
+    uint64_t too_late() const { return too_late_; }
+
+    // Missing and lost sequences over all sequences up to the highest one
+    double loss_rate() const {
+        uint64_t total = expected();
+        return total > 0 ? static_cast<double>(missing_ + lost_) / total : 0.0;
+    }
+
+    // Up to 'limit' oldest missing runs in the window as [first, last] pairs.
+    // Scans the bitmap, so it is meant for display, not for the receive path.
+    std::vector<std::pair<uint64_t, uint64_t>> missing_ranges(size_t limit) const {
+        std::vector<std::pair<uint64_t, uint64_t>> ranges;
+        if (!started_ || missing_ == 0) return ranges;
+        uint64_t seq = base_;
+        while (seq < highest_ && ranges.size() < limit) {
+            if (test(seq)) {
+                ++seq;
+                continue;
+            }
+            uint64_t start = seq;
+            while (!test(seq)) ++seq;  // stops at highest_ at the latest
+            ranges.push_back(std::make_pair(start, seq - 1));
+        }
+        return ranges;
+    }
+};
+
+#endif  // DDS_PRACTICE_COMMON_GAPTRACKER_HPP_
@@ -0,0 +1,104 @@
+#ifndef DDS_PRACTICE_COMMON_LATENCYHISTOGRAM_HPP_
+#define DDS_PRACTICE_COMMON_LATENCYHISTOGRAM_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// HDR-style log-linear histogram for latency values (nanoseconds).
+// Each power-of-two range is split into 64 linear sub-buckets, so every
+// recorded value is kept with ~1.5% relative precision in constant memory
+// and record() is O(1) with no allocation.
+class LatencyHistogram {
+private:
+    static const int kSubBucketBits = 7;                          // 128 sub-buckets in bucket 0
+    static const uint64_t kSubBucketCount = 1ULL << kSubBucketBits;
+    static const uint64_t kSubBucketHalf = kSubBucketCount / 2;
+    static const int kMaxValueBits = 40;                          // ~18 minutes in ns
+
+    std::vector<uint64_t> counts_;
+    uint64_t total_count_;
+    uint64_t min_;
+    uint64_t max_;
+    double sum_;
+
+    static int highest_bit(uint64_t value) {
+        int bit = 0;
+        while (value >>= 1) ++bit;
+        return bit;
+    }
+
+    static size_t index_of(uint64_t value) {
+        int bucket = std::max(0, highest_bit(value) - (kSubBucketBits - 1));
+        uint64_t sub = value >> bucket;
+        return static_cast<size_t>(bucket * kSubBucketHalf + sub);
+    }
+
+    // Highest value that maps into the same sub-bucket as index
+    static uint64_t value_at(size_t index) {
+        if (index < kSubBucketCount) return index;
+        int bucket = static_cast<int>(index / kSubBucketHalf) - 1;
+        uint64_t sub = index - bucket * kSubBucketHalf;
+        return (sub << bucket) + ((1ULL << bucket) - 1);
+    }
+
+public:
+    LatencyHistogram()
+        : counts_((kMaxValueBits - kSubBucketBits + 2) * kSubBucketHalf, 0) {
+        reset();
+    }
+
+    void reset() {
+        std::fill(counts_.begin(), counts_.end(), 0);
+        total_count_ = 0;
+        min_ = std::numeric_limits<uint64_t>::max();
+        max_ = 0;
+        sum_ = 0.0;
+    }
+
+    void record(uint64_t value) {
+        const uint64_t highest = (1ULL << kMaxValueBits) - 1;
+        if (value > highest) value = highest;
+
+        counts_[index_of(value)]++;
+        total_count_++;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+        sum_ += static_cast<double>(value);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        total_count_ += other.total_count_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        sum_ += other.sum_;
+    }
+
+    // percentile in [0, 100]
+    uint64_t percentile(double percentile) const {
+        if (total_count_ == 0) return 0;
+
+        uint64_t target = static_cast<uint64_t>(percentile / 100.0 * total_count_ + 0.5);
+        target = std::max<uint64_t>(1, std::min(target, total_count_));
+
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            cumulative += counts_[i];
+            if (cumulative >= target) {
+                return std::min(value_at(i), max_);
+            }
+        }
+        return max_;
+    }
+
+    uint64_t count() const { return total_count_; }
+    uint64_t min() const { return total_count_ == 0 ? 0 : min_; }
+    uint64_t max() const { return max_; }
+    double mean() const { return total_count_ == 0 ? 0.0 : sum_ / total_count_; }
+};
+
+#endif  // DDS_PRACTICE_COMMON_LATENCYHISTOGRAM_HPP_
@@ -0,0 +1,255 @@
+#ifndef DDS_PRACTICE_COMMON_PERIODICSCHEDULER_HPP_
+#define DDS_PRACTICE_COMMON_PERIODICSCHEDULER_HPP_
+
+#include "LatencyHistogram.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Fixed-rate pacing on absolute deadlines (steady_clock + sleep_until).
+// Deadlines advance by exactly one period per cycle, so the time spent
+// publishing does not accumulate as drift. If a cycle runs past one or more
+// deadlines they are counted as overruns and skipped instead of bursting to
+// catch up. Wake-up jitter (actual wake - deadline) is kept in a histogram.
+class PeriodicTimer {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+private:
+    Clock::duration period_;
+    Clock::time_point next_deadline_;
+    Clock::time_point start_;
+    uint64_t cycles_;
+    uint64_t overruns_;
+    LatencyHistogram jitter_;
+
+public:
+    explicit PeriodicTimer(Clock::duration period)
+        : period_(period)
+        , next_deadline_(Clock::now() + period)
+        , start_(Clock::now())
+        , cycles_(0)
+        , overruns_(0) {
+    }
+
+    static Clock::duration period_from_rate(double rate_hz) {
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate_hz));
+    }
+
+    // Restarts the phase: the next deadline is one new period from now
+    void set_period(Clock::duration period) {
+        period_ = period;
+        next_deadline_ = Clock::now() + period_;
+    }
+
+    Clock::duration period() const { return period_; }
+    Clock::time_point next_deadline() const { return next_deadline_; }
+
+    // Sleeps until the next deadline (or until the given limit, whichever is first).
+    // Returns true when the deadline was reached and a new cycle should run.
+    bool wait(Clock::time_point limit = Clock::time_point::max()) {
+        if (limit < next_deadline_) {
+            std::this_thread::sleep_until(limit);
+            return false;
+        }
+        std::this_thread::sleep_until(next_deadline_);
+        on_deadline(Clock::now());
+        return true;
+    }
+
+    // Accounts a cycle started at 'now' and schedules the next deadline
+    void on_deadline(Clock::time_point now) {
+        jitter_.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - next_deadline_).count()));
+        cycles_++;
+
+        next_deadline_ += period_;
+        if (now >= next_deadline_) {
+            // Already late for the next cycle: skip the missed deadlines
+            uint64_t missed = static_cast<uint64_t>((now - next_deadline_) / period_) + 1;
+            overruns_ += missed;
+            next_deadline_ += period_ * static_cast<Clock::rep>(missed);
+        }
+    }
+
+    uint64_t cycles() const { return cycles_; }
+    uint64_t overruns() const { return overruns_; }
+    const LatencyHistogram& jitter() const { return jitter_; }
+
+    double achieved_rate() const {
+        double elapsed = std::chrono::duration<double>(Clock::now() - start_).count();
+        return elapsed > 0.0 ? cycles_ / elapsed : 0.0;
+    }
+
+    void reset_stats() {
+        cycles_ = 0;
+        overruns_ = 0;
+        jitter_.reset();
+        start_ = Clock::now();
+    }
+};
+
+// Runs several periodic tasks, each at its own rate, either all from a
+// single thread (run) or each on its own thread (run_threaded).
+// A rate of 0 pauses the task.
+class PeriodicScheduler {
+public:
+    typedef std::function<void()> Task;
+    typedef PeriodicTimer::Clock Clock;
+
+private:
+    struct Entry {
+        std::string name;
+        double rate_hz;
+        double pending_rate_hz;
+        PeriodicTimer timer;
+        Task task;
+
+        Entry(const std::string& n, double rate, Task t)
+            : name(n)
+            , rate_hz(rate)
+            , pending_rate_hz(rate)
+            , timer(PeriodicTimer::period_from_rate(rate > 0.0 ? rate : 1.0))
+            , task(t) {}
+    };
+
+    std::vector<Entry> entries_;  // all tasks are added before run()
+    mutable std::mutex mutex_;  // guards rates and timer statistics
+
+    // Called with mutex_ held
+    static void apply_pending_rate(Entry& entry) {
+        if (entry.pending_rate_hz == entry.rate_hz) return;
+        entry.rate_hz = entry.pending_rate_hz;
+        if (entry.rate_hz > 0.0) {
+            entry.timer.set_period(PeriodicTimer::period_from_rate(entry.rate_hz));
+            entry.timer.reset_stats();
+        }
+    }
+
+    void run_entry(Entry& entry, const std::atomic<bool>& running) {
+        while (running) {
+            bool active;
+            Clock::time_point deadline;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                apply_pending_rate(entry);
+                active = entry.rate_hz > 0.0;
+                deadline = entry.timer.next_deadline();
+            }
+
+            Clock::time_point slice = Clock::now() + std::chrono::milliseconds(100);
+            if (!active || slice < deadline) {
+                std::this_thread::sleep_until(slice);
+                continue;
+            }
+            std::this_thread::sleep_until(deadline);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                entry.timer.on_deadline(Clock::now());
+            }
+            entry.task();
+        }
+    }
+
+public:
+    void add_task(const std::string& name, double rate_hz, Task task) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.push_back(Entry(name, rate_hz, task));
+    }
+
+    bool set_rate(const std::string& name, double rate_hz) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& entry : entries_) {
+            if (entry.name == name) {
+                entry.pending_rate_hz = rate_hz;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Blocks until running becomes false. Sleeps in slices of at most
+    // 100 ms so a stop request is noticed even with slow tasks.
+    void run(const std::atomic<bool>& running) {
+        while (running) {
+            Entry* next = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (auto& entry : entries_) {
+                    apply_pending_rate(entry);
+                    if (entry.rate_hz <= 0.0) continue;
+                    if (next == nullptr || entry.timer.next_deadline() < next->timer.next_deadline()) {
+                        next = &entry;
+                    }
+                }
+            }
+
+            Clock::time_point slice = Clock::now() + std::chrono::milliseconds(100);
+            if (next == nullptr) {
+                std::this_thread::sleep_until(slice);
+                continue;
+            }
+
+            Clock::time_point deadline = next->timer.next_deadline();
+            if (slice < deadline) {
+                std::this_thread::sleep_until(slice);
+                continue;
+            }
+            std::this_thread::sleep_until(deadline);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                next->timer.on_deadline(Clock::now());
+            }
+            next->task();
+        }
+    }
+
+    // Blocks until running becomes false. Every task gets its own thread, so a
+    // slow task only delays itself.
+    void run_threaded(const std::atomic<bool>& running) {
+        std::vector<std::thread> threads;
+        for (auto& entry : entries_) {
+            Entry* task_entry = &entry;
+            threads.push_back(std::thread([this, task_entry, &running]() {
+                run_entry(*task_entry, running);
+            }));
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    void print_stats(std::ostream& out) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        out << std::left << std::setw(12) << "Task"
+            << std::right << std::setw(10) << "Rate(Hz)"
+            << std::setw(12) << "Actual(Hz)"
+            << std::setw(10) << "Cycles"
+            << std::setw(10) << "Overruns"
+            << std::setw(16) << "Jitter p50(us)"
+            << std::setw(12) << "p99(us)"
+            << std::setw(12) << "max(us)" << "\n";
+        for (const auto& entry : entries_) {
+            const LatencyHistogram& jitter = entry.timer.jitter();
+            out << std::left << std::setw(12) << entry.name
+                << std::right << std::fixed << std::setprecision(1)
+                << std::setw(10) << entry.rate_hz
+                << std::setw(12) << entry.timer.achieved_rate()
+                << std::setw(10) << entry.timer.cycles()
+                << std::setw(10) << entry.timer.overruns()
+                << std::setw(16) << jitter.percentile(50.0) / 1000.0
+                << std::setw(12) << jitter.percentile(99.0) / 1000.0
+                << std::setw(12) << jitter.max() / 1000.0 << "\n";
+        }
+    }
+};
+
+#endif  // DDS_PRACTICE_COMMON_PERIODICSCHEDULER_HPP_
@@ -0,0 +1,27 @@
+#ifndef DDS_PRACTICE_COMMON_PROCESSMEMORY_HPP_
+#define DDS_PRACTICE_COMMON_PROCESSMEMORY_HPP_
+
+#include <cstddef>
+#include <fstream>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+// Resident set size of this process in bytes (Linux: /proc/self/statm),
+// 0 where it is not available. Differences between two readings estimate
+// what a step allocated, e.g. memory per registered instance; the heap does
+// not return every freed page, so it is an estimate, not an exact count.
+inline size_t resident_bytes() {
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    if (statm >> total_pages >> resident_pages) {
+        return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return 0;
+}
+
+#endif  // DDS_PRACTICE_COMMON_PROCESSMEMORY_HPP_
@@ -0,0 +1,96 @@
+#ifndef DDS_PRACTICE_COMMON_RCUVALUE_HPP_
+#define DDS_PRACTICE_COMMON_RCUVALUE_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Read-copy-update holder for state read on a hot path and changed rarely
+// (tables filled by discovery, user toggles). update() copies the current
+// value, applies fn to the copy and publishes it with one atomic pointer
+// exchange; the mutex only orders updaters.
+//
+// Readers are lock-free: load() returns a Snapshot that counts the caller
+// as an active reader (one atomic increment, one pointer load) and keeps
+// the value it saw alive until the Snapshot is destroyed (one atomic
+// decrement). A replaced value is retired and freed by a later update()
+// that sees no active reader: a reader that loaded the old pointer
+// registered before the exchange, so a zero count after the exchange
+// means it has finished. Readers never wait for an updater and never free
+// anything; updaters never wait for readers. Keep snapshots short (one
+// batch, one frame) so retired values do not pile up.
+template<typename T>
+class RcuValue {
+private:
+    std::atomic<const T*> current_;
+    mutable std::atomic<uint32_t> readers_;
+    std::mutex update_mtx_;           // orders updaters only, never taken by readers
+    std::vector<const T*> retired_;   // replaced values some reader may still hold
+
+    void reclaim() {
+        // seq_cst pairs with the readers' increment-then-load
+        if (readers_.load(std::memory_order_seq_cst) != 0) return;
+        for (const T* value : retired_) delete value;
+        retired_.clear();
+    }
+
+public:
+    class Snapshot {
+    private:
+        const RcuValue* owner_;
+        const T* value_;
+
+    public:
+        explicit Snapshot(const RcuValue& owner)
+            : owner_(&owner) {
+            owner.readers_.fetch_add(1, std::memory_order_seq_cst);
+            value_ = owner.current_.load(std::memory_order_seq_cst);
+        }
+
+        Snapshot(Snapshot&& other) noexcept
+            : owner_(other.owner_)
+            , value_(other.value_) {
+            other.owner_ = nullptr;
+        }
+
+        ~Snapshot() {
+            if (owner_ != nullptr) owner_->readers_.fetch_sub(1, std::memory_order_release);
+        }
+
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+        Snapshot& operator=(Snapshot&&) = delete;
+
+        const T& operator*() const { return *value_; }
+        const T* operator->() const { return value_; }
+    };
+
+    RcuValue()
+        : current_(new T())
+        , readers_(0) {}
+
+    // No reader may be active any more
+    ~RcuValue() {
+        delete current_.load(std::memory_order_relaxed);
+        for (const T* value : retired_) delete value;
+    }
+
+    RcuValue(const RcuValue&) = delete;
+    RcuValue& operator=(const RcuValue&) = delete;
+
+    Snapshot load() const { return Snapshot(*this); }
+
+    // Applies fn to a copy of the current value and publishes the result
+    template<typename Fn>
+    void update(Fn fn) {
+        std::lock_guard<std::mutex> lock(update_mtx_);
+        std::unique_ptr<T> next(new T(*current_.load(std::memory_order_relaxed)));
+        fn(*next);
+        retired_.push_back(current_.exchange(next.release(), std::memory_order_seq_cst));
+        reclaim();
+    }
+};
+
+#endif  // DDS_PRACTICE_COMMON_RCUVALUE_HPP_
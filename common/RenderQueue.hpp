@@ -0,0 +1,145 @@
+#ifndef DDS_PRACTICE_COMMON_RENDERQUEUE_HPP_
+#define DDS_PRACTICE_COMMON_RENDERQUEUE_HPP_
+
+#include "PeriodicScheduler.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+
+// Bounded lock-free MPSC queue between DataReaderListeners and a render thread.
+// Listener callbacks may run on several Fast DDS receive threads (SHM, UDP), so
+// push() is safe from many producers; pop() is called by the render thread only.
+// push() never blocks: when the queue is full the sample is dropped and counted,
+// so a slow terminal can not stall the transport.
+// (Bounded MPMC ring by D. Vyukov: each cell carries a sequence number.)
+template<typename T>
+class RenderQueue {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> enqueue_pos_;
+    alignas(64) std::atomic<size_t> dequeue_pos_;
+    alignas(64) std::atomic<uint64_t> pushed_;
+    std::atomic<uint64_t> dropped_;
+
+    static size_t round_up_pow2(size_t value) {
+        size_t result = 2;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+    template<typename U>
+    bool emplace(U&& value) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.data = std::forward<U>(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    pushed_.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            } else if (diff < 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+public:
+    explicit RenderQueue(size_t capacity = 256)
+        : cells_(new Cell[round_up_pow2(capacity)])
+        , mask_(round_up_pow2(capacity) - 1)
+        , enqueue_pos_(0)
+        , dequeue_pos_(0)
+        , pushed_(0)
+        , dropped_(0) {
+        for (size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    RenderQueue(const RenderQueue&) = delete;
+    RenderQueue& operator=(const RenderQueue&) = delete;
+
+    bool push(const T& value) { return emplace(value); }
+    bool push(T&& value) { return emplace(std::move(value)); }
+
+    // Consumer side (single thread). Swaps instead of moving, so the buffers of
+    // the consumer's previous sample go back into the cell and a later push()
+    // copies into existing string/vector capacity instead of allocating.
+    bool pop(T& value) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[pos & mask_];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1) < 0) {
+            return false;  // empty
+        }
+        using std::swap;
+        swap(value, cell.data);
+        cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+        dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+    uint64_t pushed() const { return pushed_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+};
+
+// Calls a frame function from its own thread at a capped frame rate.
+// The frame function drains the queues and redraws only if something changed.
+class RenderLoop {
+private:
+    std::thread thread_;
+    std::atomic<bool> running_;
+    double fps_;
+
+public:
+    explicit RenderLoop(double fps = 10.0)
+        : running_(false)
+        , fps_(fps > 0.0 ? fps : 10.0) {}
+
+    ~RenderLoop() {
+        stop();
+    }
+
+    double fps() const { return fps_; }
+
+    void start(std::function<void()> frame) {
+        stop();
+        running_ = true;
+        thread_ = std::thread([this, frame]() {
+            PeriodicTimer timer(PeriodicTimer::period_from_rate(fps_));
+            while (running_) {
+                frame();
+                timer.wait();
+            }
+            frame();  // flush what arrived during the last period
+        });
+    }
+
+    void stop() {
+        running_ = false;
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+};
+
+#endif  // DDS_PRACTICE_COMMON_RENDERQUEUE_HPP_
@@ -0,0 +1,76 @@
+#ifndef DDS_PRACTICE_COMMON_RINGBUFFER_HPP_
+#define DDS_PRACTICE_COMMON_RINGBUFFER_HPP_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Fixed-capacity history of the newest elements in one contiguous array.
+// Once full, each push() overwrites the oldest element, so memory stays at
+// 'capacity' elements however long the stream runs. Index 0 is the oldest
+// element, size() - 1 the newest. Single-threaded.
+template<typename T>
+class RingBuffer {
+private:
+    std::vector<T> slots_;
+    size_t head_;  // slot written by the next push()
+    size_t size_;
+
+    size_t slot(size_t index) const {
+        size_t oldest = head_ + slots_.size() - size_;
+        return (oldest + index) % slots_.size();
+    }
+
+    void advance() {
+        head_ = (head_ + 1) % slots_.size();
+        if (size_ < slots_.size()) size_++;
+    }
+
+public:
+    explicit RingBuffer(size_t capacity = 1)
+        : slots_(capacity > 0 ? capacity : 1)
+        , head_(0)
+        , size_(0) {}
+
+    void push(const T& value) {
+        slots_[head_] = value;
+        advance();
+    }
+
+    // Swaps instead of copying: 'value' gets the evicted element back, so a
+    // caller that reuses it keeps the old string/vector capacity around
+    void push(T&& value) {
+        using std::swap;
+        swap(slots_[head_], value);
+        advance();
+    }
+
+    const T& operator[](size_t index) const { return slots_[slot(index)]; }
+    T& operator[](size_t index) { return slots_[slot(index)]; }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return slots_.size(); }
+    bool empty() const { return size_ == 0; }
+
+    void clear() {
+        head_ = 0;
+        size_ = 0;
+    }
+
+    // Keeps the newest min(size(), capacity) elements
+    void set_capacity(size_t capacity) {
+        if (capacity == 0) capacity = 1;
+        if (capacity == slots_.size()) return;
+
+        size_t keep = size_ < capacity ? size_ : capacity;
+        std::vector<T> slots(capacity);
+        for (size_t i = 0; i < keep; ++i) {
+            slots[i] = std::move((*this)[size_ - keep + i]);
+        }
+        slots_.swap(slots);
+        size_ = keep;
+        head_ = keep % capacity;
+    }
+};
+
+#endif  // DDS_PRACTICE_COMMON_RINGBUFFER_HPP_
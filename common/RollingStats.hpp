@@ -0,0 +1,159 @@
+#ifndef DDS_PRACTICE_COMMON_ROLLINGSTATS_HPP_
+#define DDS_PRACTICE_COMMON_ROLLINGSTATS_HPP_
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+// Sliding-window statistics over N value streams sampled together (e.g.
+// temperature, humidity and pressure of one sensor). The window is bounded
+// by a sample count and/or an age; add() and the evictions it triggers are
+// O(1) amortized per sample:
+//   mean / stddev  Welford's running mean and M2, with the inverse update
+//                  when a sample leaves the window
+//   min / max      monotonic deques (each sample is pushed and popped once)
+//   percentiles    fixed-range bucket counts, so a query is O(buckets) and
+//                  accurate to one bucket width; values outside the range
+//                  are counted in the first or last bucket
+// The per-sample updates run over all N fields in plain loops on arrays.
+template<size_t N>
+class RollingStats {
+public:
+    typedef std::array<double, N> Values;
+
+    struct Range {
+        double lo;
+        double hi;
+    };
+
+private:
+    struct Entry {
+        int64_t timestamp_ns;
+        uint64_t index;
+        Values values;
+    };
+
+    size_t max_count_;    // 0 = no count limit
+    int64_t max_age_ns_;  // 0 = no age limit
+    std::array<Range, N> ranges_;
+    size_t bucket_count_;
+
+    std::deque<Entry> window_;
+    uint64_t next_index_;
+    Values mean_;
+    Values m2_;
+    std::array<std::deque<std::pair<uint64_t, double>>, N> min_queue_;
+    std::array<std::deque<std::pair<uint64_t, double>>, N> max_queue_;
+    std::array<std::vector<uint32_t>, N> buckets_;
+
+    size_t bucket_of(size_t field, double value) const {
+        const Range& range = ranges_[field];
+        double position = (value - range.lo) / (range.hi - range.lo) * bucket_count_;
+        if (!(position > 0.0)) return 0;
+        if (position >= bucket_count_) return bucket_count_ - 1;
+        return static_cast<size_t>(position);
+    }
+
+    void pop_front() {
+        const Entry& entry = window_.front();
+        double n = static_cast<double>(window_.size() - 1);
+        for (size_t f = 0; f < N; ++f) {
+            double x = entry.values[f];
+            if (n > 0.0) {
+                double delta = x - mean_[f];
+                mean_[f] -= delta / n;
+                m2_[f] -= delta * (x - mean_[f]);
+            } else {
+                mean_[f] = 0.0;
+                m2_[f] = 0.0;
+            }
+            if (min_queue_[f].front().first == entry.index) min_queue_[f].pop_front();
+            if (max_queue_[f].front().first == entry.index) max_queue_[f].pop_front();
+            buckets_[f][bucket_of(f, x)]--;
+        }
+        window_.pop_front();
+    }
+
+public:
+    RollingStats(size_t max_count, int64_t max_age_ns, const std::array<Range, N>& ranges,
+                 size_t bucket_count = 128)
+        : max_count_(max_count)
+        , max_age_ns_(max_age_ns)
+        , ranges_(ranges)
+        , bucket_count_(bucket_count > 0 ? bucket_count : 1)
+        , next_index_(0) {
+        mean_.fill(0.0);
+        m2_.fill(0.0);
+        for (size_t f = 0; f < N; ++f) {
+            buckets_[f].assign(bucket_count_, 0);
+        }
+    }
+
+    void add(int64_t timestamp_ns, const Values& values) {
+        Entry entry = {timestamp_ns, next_index_++, values};
+        window_.push_back(entry);
+
+        double n = static_cast<double>(window_.size());
+        for (size_t f = 0; f < N; ++f) {
+            double x = values[f];
+            double delta = x - mean_[f];
+            mean_[f] += delta / n;
+            m2_[f] += delta * (x - mean_[f]);
+
+            while (!min_queue_[f].empty() && min_queue_[f].back().second >= x) min_queue_[f].pop_back();
+            min_queue_[f].push_back(std::make_pair(entry.index, x));
+            while (!max_queue_[f].empty() && max_queue_[f].back().second <= x) max_queue_[f].pop_back();
+            max_queue_[f].push_back(std::make_pair(entry.index, x));
+
+            buckets_[f][bucket_of(f, x)]++;
+        }
+
+        if (max_count_ > 0) {
+            while (window_.size() > max_count_) pop_front();
+        }
+        expire(timestamp_ns);
+    }
+
+    // Drops the samples older than the age limit relative to now_ns. Also
+    // called by add(); call it before reading when samples may have stopped.
+    void expire(int64_t now_ns) {
+        if (max_age_ns_ <= 0) return;
+        while (!window_.empty() && window_.front().timestamp_ns < now_ns - max_age_ns_) pop_front();
+    }
+
+    size_t count() const { return window_.size(); }
+    bool empty() const { return window_.empty(); }
+
+    double mean(size_t field) const { return mean_[field]; }
+
+    double stddev(size_t field) const {
+        if (window_.size() < 2) return 0.0;
+        double variance = m2_[field] / static_cast<double>(window_.size() - 1);
+        return variance > 0.0 ? std::sqrt(variance) : 0.0;
+    }
+
+    double min(size_t field) const { return min_queue_[field].empty() ? 0.0 : min_queue_[field].front().second; }
+    double max(size_t field) const { return max_queue_[field].empty() ? 0.0 : max_queue_[field].front().second; }
+
+    // percentile in [0, 100]; the midpoint of the bucket holding it
+    double percentile(size_t field, double percentile) const {
+        if (window_.empty()) return 0.0;
+        uint64_t target = static_cast<uint64_t>(percentile / 100.0 * window_.size() + 0.5);
+        if (target < 1) target = 1;
+
+        const Range& range = ranges_[field];
+        double width = (range.hi - range.lo) / bucket_count_;
+        uint64_t cumulative = 0;
+        for (size_t b = 0; b < bucket_count_; ++b) {
+            cumulative += buckets_[field][b];
+            if (cumulative >= target) return range.lo + (b + 0.5) * width;
+        }
+        return range.hi;
+    }
+};
+
+#endif  // DDS_PRACTICE_COMMON_ROLLINGSTATS_HPP_
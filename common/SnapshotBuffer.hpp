@@ -0,0 +1,61 @@
+#ifndef DDS_PRACTICE_COMMON_SNAPSHOTBUFFER_HPP_
+#define DDS_PRACTICE_COMMON_SNAPSHOTBUFFER_HPP_
+
+#include <atomic>
+#include <mutex>
+
+// Triple buffer holding the latest state of a sample.
+// Producers (user input, random generator) modify a private working copy and
+// publish it into a free slot; the single consumer (the publishing thread)
+// swaps the newest slot in with one atomic exchange and never waits, so
+// DataWriter::write() runs on a consistent snapshot without holding any lock
+// a producer needs. Works for any copyable type (strings, sequences), unlike
+// a seqlock, which needs trivially copyable data.
+//
+// Only the consumer side is wait-free. Producer updates are read-modify-
+// writes of the same working copy (the generator walks from the current
+// values, set_value() changes one field), so concurrent producers have to
+// be ordered. A compare-and-swap retry on whole snapshots would be
+// lock-free at best, not wait-free, and would copy the sample (strings,
+// sequences) on every retry. producer_mtx_ is therefore kept. It is
+// contended only by the interactive input and the generator, and is held
+// for one field update and one copy, never across DataWriter::write().
+template<typename T>
+class SnapshotBuffer {
+private:
+    static const int kIndexMask = 0x3;
+    static const int kFresh = 0x4;  // set when middle holds an unread snapshot
+
+    T buffers_[3];
+    T state_;                  // producers' working copy
+    std::mutex producer_mtx_;  // orders producers only, never taken by the consumer
+    int back_;                 // slot owned by the producers
+    std::atomic<int> middle_;  // slot exchanged between both sides
+    int front_;                // slot owned by the consumer
+
+public:
+    SnapshotBuffer()
+        : back_(2)
+        , middle_(1)
+        , front_(0) {}
+
+    // Applies fn to the working copy and publishes the result
+    template<typename Fn>
+    void update(Fn fn) {
+        std::lock_guard<std::mutex> lock(producer_mtx_);
+        fn(state_);
+        buffers_[back_] = state_;
+        back_ = middle_.exchange(back_ | kFresh, std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    // Consumer side (single thread). Returns the newest snapshot; it stays
+    // valid and private to the consumer until the next acquire().
+    T& acquire() {
+        if (middle_.load(std::memory_order_acquire) & kFresh) {
+            front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+        }
+        return buffers_[front_];
+    }
+};
+
+#endif  // DDS_PRACTICE_COMMON_SNAPSHOTBUFFER_HPP_
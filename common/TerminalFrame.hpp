@@ -0,0 +1,124 @@
+#ifndef DDS_PRACTICE_COMMON_TERMINALFRAME_HPP_
+#define DDS_PRACTICE_COMMON_TERMINALFRAME_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Frame model for the terminal dashboards. A frame is written into begin()'s
+// stream like into std::cout; present() compares it with the frame on screen
+// line by line and rewrites only the lines that changed (cursor positioning
+// + erase to end of line), instead of clearing the screen and printing the
+// whole table again. The first frame, and the one after invalidate(), is
+// drawn in full. Lines must fit the terminal width: a wrapped line shifts
+// the rows below it. Used from the render thread only, except invalidate(),
+// which the thread printing other output to the terminal calls; the stream
+// keeps its formatting flags between frames, like std::cout.
+//
+// A frame that does not end in '\n' (an input prompt) has its last line
+// rewritten every time, so the cursor is left at the end of it. Otherwise
+// the cursor is parked on the line below the frame.
+class TerminalFrame {
+private:
+    std::ostringstream buffer_;
+    std::vector<std::string> shown_;  // lines on screen
+    std::vector<std::string> next_;
+    size_t shown_lines_;
+    bool valid_;  // shown_ matches the screen
+    std::atomic<bool> invalidated_;  // set by invalidate(), from any thread
+    std::string output_;
+    uint64_t lines_written_;
+
+    static void move_to(std::string& out, size_t line) {
+        out += "\033[";
+        out += std::to_string(line + 1);
+        out += ";1H";
+    }
+
+public:
+    TerminalFrame()
+        : shown_lines_(0)
+        , valid_(false)
+        , invalidated_(false)
+        , lines_written_(0) {}
+
+    // Starts a new frame and returns the stream to print it into
+    std::ostream& begin() {
+        buffer_.str(std::string());
+        buffer_.clear();
+        return buffer_;
+    }
+
+    std::ostream& stream() { return buffer_; }
+
+    // Draws the next present() in full, e.g. after other output scrolled the
+    // screen. Safe to call from any thread.
+    void invalidate() { invalidated_.store(true, std::memory_order_relaxed); }
+
+    // True if the next present() redraws the whole frame: the caller should
+    // present one even if its content did not change
+    bool invalidated() const {
+        return !valid_ || invalidated_.load(std::memory_order_relaxed);
+    }
+
+    // Writes the changed lines of the frame to the terminal.
+    // Returns the number of lines written.
+    size_t present(std::ostream& terminal = std::cout) {
+        const std::string text = buffer_.str();
+        size_t lines = 0;
+        for (size_t start = 0; start < text.size(); ++lines) {
+            size_t end = text.find('\n', start);
+            if (end == std::string::npos) end = text.size();
+            if (lines == next_.size()) next_.emplace_back();
+            next_[lines].assign(text, start, end - start);
+            start = end + 1;
+        }
+        bool prompt = !text.empty() && text[text.size() - 1] != '\n';
+
+        if (invalidated_.exchange(false, std::memory_order_relaxed)) {
+            valid_ = false;
+        }
+        output_.clear();
+        if (!valid_) {
+            output_ += "\033[2J";
+        }
+        size_t body = prompt ? lines - 1 : lines;
+        size_t written = 0;
+        for (size_t line = 0; line < body; ++line) {
+            if (valid_ && line < shown_lines_ && shown_[line] == next_[line]) continue;
+            move_to(output_, line);
+            output_ += next_[line];
+            output_ += "\033[K";
+            ++written;
+        }
+        if (valid_ && lines < shown_lines_) {
+            move_to(output_, lines);
+            output_ += "\033[J";  // the frame got shorter
+        }
+        if (prompt) {
+            move_to(output_, body);
+            output_ += next_[body];
+            output_ += "\033[K";
+            ++written;
+        } else {
+            move_to(output_, lines);
+        }
+        terminal << output_;
+        terminal.flush();
+
+        shown_.swap(next_);
+        shown_lines_ = lines;
+        valid_ = true;
+        lines_written_ += written;
+        return written;
+    }
+
+    // Lines written to the terminal so far
+    uint64_t lines_written() const { return lines_written_; }
+};
+
+#endif  // DDS_PRACTICE_COMMON_TERMINALFRAME_HPP_
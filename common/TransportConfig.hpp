@@ -0,0 +1,120 @@
+#ifndef DDS_PRACTICE_COMMON_TRANSPORTCONFIG_HPP_
+#define DDS_PRACTICE_COMMON_TRANSPORTCONFIG_HPP_
+
+#include <fastdds/dds/domain/qos/DomainParticipantQos.hpp>
+#include <fastdds/rtps/transport/shared_mem/SharedMemTransportDescriptor.h>
+#include <fastdds/rtps/transport/UDPv4TransportDescriptor.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+// Transport selection shared by the examples' participants.
+//  DEFAULT : Fast DDS builtin transports (UDPv4 + SHM)
+//  SHM     : Shared memory only, for processes on the same host
+//  UDP     : UDPv4 only
+//  SHM_UDP : Shared memory first, UDPv4 as fallback for remote participants
+enum class TransportKind {
+    DEFAULT,
+    SHM,
+    UDP,
+    SHM_UDP
+};
+
+struct TransportOptions {
+    TransportKind kind;
+    uint32_t shm_segment_size;         // bytes, 0 = Fast DDS default
+    uint32_t shm_port_queue_capacity;  // messages, 0 = Fast DDS default
+
+    TransportOptions()
+        : kind(TransportKind::DEFAULT)
+        , shm_segment_size(0)
+        , shm_port_queue_capacity(0) {}
+};
+
+inline bool parse_transport_kind(const std::string& name, TransportKind& kind) {
+    if (name == "default") kind = TransportKind::DEFAULT;
+    else if (name == "shm") kind = TransportKind::SHM;
+    else if (name == "udp") kind = TransportKind::UDP;
+    else if (name == "shm+udp") kind = TransportKind::SHM_UDP;
+    else return false;
+    return true;
+}
+
+inline const char* transport_kind_name(TransportKind kind) {
+    switch (kind) {
+        case TransportKind::SHM: return "shm";
+        case TransportKind::UDP: return "udp";
+        case TransportKind::SHM_UDP: return "shm+udp";
+        default: return "default";
+    }
+}
+
+// Parses a positive decimal uint32_t; rejects signs, trailing text and 0
+// (0 would silently mean "Fast DDS default")
+inline bool parse_transport_uint32(const char* text, uint32_t& value) {
+    if (*text < '0' || *text > '9') return false;
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long parsed = std::strtoull(text, &end, 10);
+    if (*end != '\0' || errno != 0 || parsed == 0 || parsed > UINT32_MAX) return false;
+    value = static_cast<uint32_t>(parsed);
+    return true;
+}
+
+// Consumes a transport option at argv[i] (advancing i past its value).
+// Returns false if argv[i] is not a transport option or its value is invalid.
+inline bool parse_transport_arg(int argc, char** argv, int& i, TransportOptions& options) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) return false;
+
+    if (arg == "--transport") {
+        return parse_transport_kind(argv[++i], options.kind);
+    } else if (arg == "--shm-segment-size") {
+        return parse_transport_uint32(argv[++i], options.shm_segment_size);
+    } else if (arg == "--shm-queue-depth") {
+        return parse_transport_uint32(argv[++i], options.shm_port_queue_capacity);
+    }
+    return false;
+}
+
+inline const char* transport_usage() {
+    return "  --transport <default|shm|udp|shm+udp> : Select participant transports\n"
+           "  --shm-segment-size <bytes>             : Shared memory segment size\n"
+           "  --shm-queue-depth <n>                  : Shared memory port queue capacity\n"
+           "                                           (both ignored with --transport udp)\n";
+}
+
+// Replaces the builtin transports of the participant QoS according to options.
+// The builtin SHM transport cannot be tuned, so DEFAULT with SHM options
+// builds the same SHM + UDPv4 pair explicitly.
+inline void apply_transport(eprosima::fastdds::dds::DomainParticipantQos& qos,
+                            const TransportOptions& options) {
+    TransportKind kind = options.kind;
+    if (kind == TransportKind::DEFAULT) {
+        if (options.shm_segment_size == 0 && options.shm_port_queue_capacity == 0) return;
+        kind = TransportKind::SHM_UDP;
+    }
+
+    qos.transport().use_builtin_transports = false;
+
+    if (kind == TransportKind::SHM || kind == TransportKind::SHM_UDP) {
+        auto shm = std::make_shared<eprosima::fastdds::rtps::SharedMemTransportDescriptor>();
+        if (options.shm_segment_size > 0) {
+            shm->segment_size(options.shm_segment_size);
+        }
+        if (options.shm_port_queue_capacity > 0) {
+            shm->port_queue_capacity(options.shm_port_queue_capacity);
+        }
+        qos.transport().user_transports.push_back(shm);
+    }
+
+    if (kind == TransportKind::UDP || kind == TransportKind::SHM_UDP) {
+        auto udp = std::make_shared<eprosima::fastdds::rtps::UDPv4TransportDescriptor>();
+        qos.transport().user_transports.push_back(udp);
+    }
+}
+
+#endif  // DDS_PRACTICE_COMMON_TRANSPORTCONFIG_HPP_